@@ -34,7 +34,6 @@
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/graph/topological_sort.hpp>
 #include <boost/graph/graphviz.hpp>
-#include <boost/graph/filtered_graph.hpp>
 #include <boost/graph/iteration_macros.hpp>
 #include <boost/unordered_set.hpp>
 
@@ -47,50 +46,16 @@
 #include "controlflowgraph/statements/ParseHelpers.h"
 #include "controlflowgraph/edges/edge_types.h"
 #include "controlflowgraph/ControlFlowGraph.h"
+#include "controlflowgraph/BasicBlockGraph.h"
 #include "controlflowgraph/visitors/ControlFlowGraphVisitorBase.h"
 
 #include "libexttools/ToolDot.h"
 
 #include "gcc_gimple_parser.h"
 
-/// Property map typedef which allows us to get at the function pointer stored at
-/// CFGVertexProperties::m_containing_function in the T_CFG.
-typedef boost::property_map<T_CFG, Function* CFGVertexProperties::*>::type T_VERTEX_PROPERTY_MAP;
-
-/// Property map typedef which allows us to get at the edge type pointer stored at
-/// CFGEdgeProperties::m_edge_type in the T_CFG.
-typedef boost::property_map<T_CFG, CFGEdgeTypeBase* CFGEdgeProperties::*>::type T_EDGE_TYPE_PROPERTY_MAP;
-
-/**
- * Predicate for filtering the CFG for only the vertices of the given function.
- */
-struct vertex_filter_predicate
-{
-	vertex_filter_predicate()
-	{
-	};
-	vertex_filter_predicate(T_VERTEX_PROPERTY_MAP vertex_prop_map,
-			Function *parent_function) :
-			m_vertex_prop_map(vertex_prop_map),
-			m_parent_function(parent_function)
-	{
-	};
-	bool operator()(const T_CFG_VERTEX_DESC& vid) const
-	{
-		if (m_parent_function == get(m_vertex_prop_map, vid))
-		{
-			// This vertex belongs to the function we're concerned with.
-			return true;
-		}
-		else
-		{
-			return false;
-		}
-	};
-
-	T_VERTEX_PROPERTY_MAP m_vertex_prop_map;
-	Function *m_parent_function;
-};
+/// Property map typedef which allows us to get at the back edge flag stored at
+/// CFGEdgeProperties::m_is_back_edge in the T_CFG.
+typedef boost::property_map<T_CFG, bool CFGEdgeProperties::*>::type T_BACK_EDGE_PROPERTY_MAP;
 
 Function::Function(TranslationUnit *parent_tu, const std::string &function_id)
 {
@@ -121,23 +86,16 @@ bool Function::IsCalled() const
 void Function::Link(const std::map<std::string, Function*> &function_map,
 		T_ID_TO_FUNCTION_CALL_UNRESOLVED_MAP *unresolved_function_calls)
 {
-	T_VERTEX_PROPERTY_MAP vpm = boost::get(
-			&CFGVertexProperties::m_containing_function, *m_cfg);
-
-	vertex_filter_predicate the_filter(vpm, this);
-	typedef boost::filtered_graph<T_CFG, boost::keep_all,
-			vertex_filter_predicate> T_FILTERED_CFG;
-	T_FILTERED_CFG graph_of_this_function(*m_cfg, boost::keep_all(),
-			the_filter);
+	FunctionGraphView graph_of_this_function(*m_the_cfg, this);
 
-	boost::graph_traits<T_FILTERED_CFG>::vertex_iterator vit, vend;
-	boost::tie(vit, vend) = boost::vertices(graph_of_this_function);
+	FunctionGraphView::vertex_iterator vit, vend;
+	boost::tie(vit, vend) = vertices(graph_of_this_function);
 	for (; vit != vend; vit++)
 	{
-		FunctionCallUnresolved *fcu =
-				dynamic_cast<FunctionCallUnresolved*>((*m_cfg)[*vit].m_statement);
-		if (fcu != NULL)
+		StatementBase *sbp = (*m_cfg)[*vit].m_statement;
+		if (sbp->IsType<FunctionCallUnresolved>())
 		{
+			FunctionCallUnresolved *fcu = static_cast<FunctionCallUnresolved*>(sbp);
 			std::map<std::string, Function*>::const_iterator it;
 
 			// We found an unresolved function call.  Try to resolve it.
@@ -152,32 +110,16 @@ void Function::Link(const std::map<std::string, Function*> &function_map,
 			{
 				// Found it.
 				// Replace the FunctionCallUnresolved with a FunctionCallResolved.
-				FunctionCallResolved *fcr = new FunctionCallResolved(it->second,
-						fcu);
-				// Delete the FunctionCallUnresolved object...
-				delete fcu;
-				// ...and replace it with the FunctionCallResolved object.
+				// The FunctionCallUnresolved stays in the graph's statement arena until the graph goes away.
+				FunctionCallResolved *fcr = m_the_cfg->NewStatement<FunctionCallResolved>(it->second, fcu);
 				(*m_cfg)[*vit].m_statement = fcr;
 
 				// Now add the appropriate CFG edges.
 				// The FunctionCall->Function->entrypoint edge.
-				CFGEdgeTypeFunctionCall *call_edge_type =
-						new CFGEdgeTypeFunctionCall(fcr);
 				T_CFG_EDGE_DESC new_edge_desc;
 				bool ok;
 
-				boost::tie(new_edge_desc, ok) = boost::add_edge(*vit,
-						it->second->GetEntryVertexDescriptor(), *m_cfg);
-				if (ok)
-				{
-					// Edge was added OK, let's connect the edge properties.
-					(*m_cfg)[new_edge_desc].m_edge_type = call_edge_type;
-				}
-				else
-				{
-					// We couldn't add the edge.  This should never happen.
-					std::cerr << "ERROR: Can't add call edge." << std::endl;
-				}
+				m_the_cfg->AddEdge(*vit, it->second->GetEntryVertexDescriptor(), CFGEdgeKind::function_call, fcr);
 
 				// Add the return edge.
 				// The return edge goes from the EXIT of the called function to
@@ -186,47 +128,27 @@ void Function::Link(const std::map<std::string, Function*> &function_map,
 				// to the next statement in its containing function.
 				T_CFG_EDGE_DESC function_call_out_edge;
 
-				boost::tie(function_call_out_edge, ok) = GetFirstOutEdgeOfType<CFGEdgeTypeFallthrough>(*vit, *m_cfg);
+				boost::tie(function_call_out_edge, ok) = GetFirstOutEdgeOfKind(*vit, CFGEdgeKind::fallthrough, *m_cfg);
 				if (!ok)
 				{
 					// Couldn't find the return.
 					std::cerr
-							<< "ERROR: COULDN'T FIND OUT EDGE OF TYPE CFGEdgeTypeFallthrough"
+							<< "ERROR: COULDN'T FIND OUT EDGE OF KIND fallthrough"
 							<< std::endl;
 					std::cerr << "Edges found are:" << std::endl;
 					//PrintOutEdgeTypes(*vit, *m_cfg);
 				}
-
-				boost::tie(new_edge_desc, ok) = boost::add_edge(
-						it->second->GetExitVertexDescriptor(),
-						boost::target(function_call_out_edge, *m_cfg), *m_cfg);
-				if (ok)
+				else
 				{
-					// Return edge was added OK.  Create and connect the edge's properties.
-					CFGEdgeTypeReturn *return_edge_type = new CFGEdgeTypeReturn(
-							fcr);
-					(*m_cfg)[new_edge_desc].m_edge_type = return_edge_type;
-					// Copy the fallthrough edge's properties to the newly-added return edge.
-					/// @todo Find a cleaner way to do this.
-					return_edge_type->MarkAsBackEdge(
-							(*m_cfg)[function_call_out_edge].m_edge_type->IsBackEdge());
-
-					// Change the type of FunctionCall's out edge to a "FunctionCallBypass".
+					new_edge_desc = m_the_cfg->AddEdge(it->second->GetExitVertexDescriptor(),
+							boost::target(function_call_out_edge, *m_cfg), CFGEdgeKind::function_return, fcr);
+					// Copy the fallthrough edge's back edge flag to the newly-added return edge.
+					(*m_cfg)[new_edge_desc].m_is_back_edge = (*m_cfg)[function_call_out_edge].m_is_back_edge;
+
+					// Change the kind of FunctionCall's out edge to a "FunctionCallBypass".
 					// For graphing just the function itself, we'll look at these edges and not the
 					// call/return edges.
-					CFGEdgeTypeFunctionCallBypass *fcbp =
-							new CFGEdgeTypeFunctionCallBypass();
-					// Copy the fallthrough edge's properties to its replacement.
-					/// @todo Find a cleaner way to do this.
-					fcbp->MarkAsBackEdge(
-							(*m_cfg)[function_call_out_edge].m_edge_type->IsBackEdge());
-					delete (*m_cfg)[function_call_out_edge].m_edge_type;
-					(*m_cfg)[function_call_out_edge].m_edge_type = fcbp;
-				}
-				else
-				{
-					// We couldn't add the edge.  This should never happen.
-					std::cerr << "ERROR: Can't add return edge." << std::endl;
+					(*m_cfg)[function_call_out_edge].SetEdgeKind(CFGEdgeKind::function_call_bypass);
 				}
 			}
 		}
@@ -242,8 +164,8 @@ struct back_edge_filter_predicate
 	back_edge_filter_predicate()
 	{
 	};
-	back_edge_filter_predicate(T_EDGE_TYPE_PROPERTY_MAP &edge_type_property_map) :
-			m_edge_type_property_map(edge_type_property_map)
+	back_edge_filter_predicate(T_BACK_EDGE_PROPERTY_MAP &back_edge_property_map) :
+			m_back_edge_property_map(back_edge_property_map)
 	{
 	};
 
@@ -255,7 +177,7 @@ struct back_edge_filter_predicate
 	 */
 	bool operator()(const T_CFG_EDGE_DESC& eid) const
 	{
-		if (get(m_edge_type_property_map, eid)->IsBackEdge())
+		if (get(m_back_edge_property_map, eid))
 		{
 			// This is a back edge, filter it out.
 			return false;
@@ -267,7 +189,7 @@ struct back_edge_filter_predicate
 		}
 	};
 
-	T_EDGE_TYPE_PROPERTY_MAP m_edge_type_property_map;
+	T_BACK_EDGE_PROPERTY_MAP m_back_edge_property_map;
 };
 
 static void indent(long i)
@@ -279,55 +201,6 @@ static void indent(long i)
 	};
 }
 
-static long filtered_in_degree(T_CFG_VERTEX_DESC v, const T_CFG &cfg, bool only_decision_predecessors = false)
-{
-	boost::graph_traits<T_CFG>::in_edge_iterator ieit, ieend;
-
-	boost::tie(ieit, ieend) = boost::in_edges(v, cfg);
-
-	long i = 0;
-	bool saw_function_call_already = false;
-	for (; ieit != ieend; ++ieit)
-	{
-		if (cfg[*ieit].m_edge_type->IsBackEdge())
-		{
-			// Always skip anything marked as a back edge.
-			continue;
-		}
-
-		if(only_decision_predecessors)
-		{
-			// Is the predecessor a decision statement?
-			if(!cfg[boost::source(*ieit,cfg)].m_statement->IsDecisionStatement())
-			{
-				continue;
-			}
-		}
-
-		// Count up all the incoming edges, with two exceptions:
-		// - Ignore Return edges.  They will always have exactly one matching FunctionCallBypass, which
-		//   is what we'll count instead.
-		// - Ignore all but the first CFGEdgeTypeFunctionCall.  The situation here is that we'd be
-		//   looking at a vertex v that's an ENTRY statement, with a predecessor of type FunctionCallResolved.
-		//   Any particular instance of an ENTRY has at most only one valid FunctionCall edge.
-		//   For our current purposes, we only care about this one.
-		if ((dynamic_cast<CFGEdgeTypeReturn*>(cfg[*ieit].m_edge_type) == NULL)
-				&& (saw_function_call_already == false))
-		{
-			i++;
-		}
-
-		if (dynamic_cast<CFGEdgeTypeFunctionCall*>(cfg[*ieit].m_edge_type)
-				!= NULL)
-		{
-			// Multiple incoming function calls only count as one for convergence purposes.
-			saw_function_call_already = true;
-		}
-	}
-
-	return i;
-}
-
 T_CFG_EDGE_DESC first_filtered_out_edge(T_CFG_VERTEX_DESC v, const T_CFG &cfg)
 {
 	boost::graph_traits<T_CFG>::in_edge_iterator ieit, ieend;
@@ -337,7 +210,7 @@ T_CFG_EDGE_DESC first_filtered_out_edge(T_CFG_VERTEX_DESC v, const T_CFG &cfg)
 	bool saw_function_call_already = false;
 	for (; ieit != ieend; ++ieit)
 	{
-		if (cfg[*ieit].m_edge_type->IsBackEdge())
+		if (cfg[*ieit].m_is_back_edge)
 		{
 			// Always skip anything marked as a back edge.
 			continue;
@@ -350,14 +223,13 @@ T_CFG_EDGE_DESC first_filtered_out_edge(T_CFG_VERTEX_DESC v, const T_CFG &cfg)
 		//   looking at a vertex v that's an ENTRY statement, with a predecessor of type FunctionCallResolved.
 		//   Any particular instance of an ENTRY has at most only one valid FunctionCall edge.
 		//   For our current purposes, we only care about this one.
-		if ((dynamic_cast<CFGEdgeTypeReturn*>(cfg[*ieit].m_edge_type) == NULL)
+		if ((cfg[*ieit].GetEdgeKind() != CFGEdgeKind::function_return)
 				&& (saw_function_call_already == false))
 		{
 			return *ieit;
 		}
 
-		if (dynamic_cast<CFGEdgeTypeFunctionCall*>(cfg[*ieit].m_edge_type)
-				!= NULL)
+		if (cfg[*ieit].GetEdgeKind() == CFGEdgeKind::function_call)
 		{
 			// Multiple incoming function calls only count as one for convergence purposes.
 			saw_function_call_already = true;
@@ -367,25 +239,6 @@ T_CFG_EDGE_DESC first_filtered_out_edge(T_CFG_VERTEX_DESC v, const T_CFG &cfg)
 	return *ieend;
 }
 
-static long filtered_out_degree(T_CFG_VERTEX_DESC v, const T_CFG &cfg)
-{
-	boost::graph_traits<T_CFG>::out_edge_iterator eit, eend;
-
-	boost::tie(eit, eend) = boost::out_edges(v, cfg);
-
-	long i = 0;
-	for (; eit != eend; ++eit)
-	{
-		if (cfg[*eit].m_edge_type->IsBackEdge())
-		{
-			// Skip anything marked as a back edge.
-			continue;
-		}
-		i++;
-	}
-	return i;
-}
-
 using std::cerr;
 using std::cout;
 using std::endl;
@@ -445,7 +298,7 @@ public:
 		}
 
 		// Check if this vertex is the first vertex of a new branch of the control flow graph.
-		long fid = filtered_in_degree(u, m_graph);
+		long fid = m_cfg.GetSnapshot().FilteredInDegree(u);
 		if(fid==1)
 		{
 			T_CFG_VERTEX_DESC predecessor;
@@ -500,7 +353,7 @@ public:
 			// check if we're going recursive.
 			FunctionCallResolved *fcr;
 
-			fcr = dynamic_cast<FunctionCallResolved*>(p);
+			fcr = static_cast<FunctionCallResolved*>(p);
 
 			// Assume we're not.
 			m_last_discovered_vertex_is_recursive = false;
@@ -525,18 +378,8 @@ public:
 	{
 		// Filter out any edges that we want to pretend aren't even part of the
 		// graph we're looking at.
-		CFGEdgeTypeBase *edge_type;
-		CFGEdgeTypeFunctionCall *fc;
-		CFGEdgeTypeReturn *ret;
-		CFGEdgeTypeFunctionCallBypass *fcb;
-
-		edge_type = m_graph[ed].m_edge_type;
-
-		// Attempt dynamic casts to call/return types to see if we need to handle
-		// these specially.
-		fc = dynamic_cast<CFGEdgeTypeFunctionCall*>(edge_type);
-		ret = dynamic_cast<CFGEdgeTypeReturn*>(edge_type);
-		fcb = dynamic_cast<CFGEdgeTypeFunctionCallBypass*>(edge_type);
+		// Get the edge's kind to see if we need to handle call/return edges specially.
+		CFGEdgeKind kind = m_graph[ed].GetEdgeKind();
 
 		if(ed.m_source == ed.m_target)
 		{
@@ -544,13 +387,13 @@ public:
 			return edge_return_value_t::terminate_branch;
 		}
 
-		if (edge_type->IsBackEdge())
+		if (m_graph[ed].m_is_back_edge)
 		{
 			// Skip all back edges.
 			return edge_return_value_t::terminate_branch;
 		}
 
-		if (ret != NULL)
+		if (kind == CFGEdgeKind::function_return)
 		{
 			// This is a return edge.
 
@@ -565,7 +408,7 @@ public:
 				cout << "NULL" << endl;
 				return edge_return_value_t::terminate_branch;
 			}
-			else if(ret->m_function_call != TopCallStack())
+			else if(m_cfg.GetEdgeFunctionCall(ed) != TopCallStack())
 			{
 				// This edge is a return, but not the one corresponding to the FunctionCall
 				// that brought us here.  Or, the call stack is empty, indicating that we got here
@@ -581,13 +424,13 @@ public:
 		// Handle recursion.
 		// We deal with recursion by deciding here which path to take out of a FunctionCallResolved vertex.
 		// Note that this is currently the only vertex type which can result in recursion.
-		if ((fcb != NULL) && (m_last_discovered_vertex_is_recursive == false))
+		if ((kind == CFGEdgeKind::function_call_bypass) && (m_last_discovered_vertex_is_recursive == false))
 		{
 			// If we're not in danger of infinite recursion,
 			// skip FunctionCallBypasses entirely.  Otherwise take them.
 			return edge_return_value_t::terminate_branch;
 		}
-		else if ((fc != NULL)
+		else if ((kind == CFGEdgeKind::function_call)
 				&& (m_last_discovered_vertex_is_recursive == true))
 		{
 			// If we are in danger of infinite recursion,
@@ -633,7 +476,7 @@ public:
 			std::cout << "}" << std::endl;
 		}
 
-		if	((num_vertices_pushed == 1) && (filtered_in_degree(boost::target(e, m_graph), m_graph) > 1))
+		if	((num_vertices_pushed == 1) && (m_cfg.GetSnapshot().FilteredInDegree(boost::target(e, m_graph)) > 1))
 		{
 			// The edge will end on a merge vertex.  Outdent.
 			m_indent_level--;
@@ -679,7 +522,7 @@ void Function::PrintControlFlowGraph(bool cfg_verbose, bool cfg_vertex_ids)
 #else
 	// Set up the visitor.
 	function_control_flow_graph_visitor cfg_visitor(*m_the_cfg, m_exit_vertex_desc, cfg_verbose, cfg_vertex_ids);
-	topological_visit_kahn(*m_cfg, m_entry_vertex_self_edge, cfg_visitor);
+	topological_visit_kahn(m_the_cfg->GetBasicBlockGraph(), m_entry_vertex_self_edge, cfg_visitor);
 #endif
 }
 
@@ -709,7 +552,7 @@ struct graph_property_writer
 class cfg_vertex_property_writer
 {
 public:
-	cfg_vertex_property_writer(T_CFG g) :	m_graph(g)	{ };
+	cfg_vertex_property_writer(T_CFG &g) :	m_graph(g)	{ };
 
 	void operator()(std::ostream& out, const T_CFG_VERTEX_DESC& v)
 	{
@@ -739,7 +582,7 @@ private:
 class cfg_edge_property_writer
 {
 public:
-	cfg_edge_property_writer(T_CFG _g) :
+	cfg_edge_property_writer(T_CFG &_g) :
 			m_graph(_g)
 	{
 	}
@@ -747,9 +590,10 @@ public:
 	{
 		// Set the edge attributes.
 		out << "[";
-		out << "label=\"" << m_graph[e].m_edge_type->GetDotLabel() << "\"";
-		out << ", color=" << m_graph[e].m_edge_type->GetDotSVGColor();
-		out << ", style=" << m_graph[e].m_edge_type->GetDotStyle();
+		const CFGEdgeTypeBase &edge_type = CFGEdgeTypeBase::GetEdgeType(m_graph[e].GetEdgeKind());
+		out << "label=\"" << edge_type.GetDotLabel() << "\"";
+		out << ", color=" << edge_type.GetDotSVGColor();
+		out << ", style=" << edge_type.GetDotStyle(m_graph[e].m_is_back_edge);
 		out << "]";
 	}
 	;
@@ -762,21 +606,18 @@ private:
 
 void Function::PrintControlFlowGraphDot(bool cfg_verbose, bool cfg_vertex_ids, const std::string & output_filename)
 {
-	T_VERTEX_PROPERTY_MAP vpm = boost::get(
-			&CFGVertexProperties::m_containing_function, *m_cfg);
-
-	vertex_filter_predicate the_filter(vpm, this);
-	boost::filtered_graph<T_CFG, boost::keep_all, vertex_filter_predicate> graph_of_this_function(
-			*m_cfg, boost::keep_all(), the_filter);
+	FunctionGraphView graph_of_this_function(*m_the_cfg, this);
 
 	std::clog << "Creating " << output_filename << std::endl;
 
 	std::ofstream outfile(output_filename.c_str());
 
+	// Name the nodes by their T_CFG vertex descriptors, which is what graph_property_writer refers to them by.
 	boost::write_graphviz(outfile, graph_of_this_function,
 			cfg_vertex_property_writer(*m_cfg),
 			cfg_edge_property_writer(*m_cfg),
-			graph_property_writer(this));
+			graph_property_writer(this),
+			boost::identity_property_map());
 
 	// graph_property_writer() added a subgraph, which "uses up" the "}" that write_graphviz streams out.
 	// Terminate the graph appropriately.
@@ -821,8 +662,9 @@ bool Function::CreateControlFlowGraph(ControlFlowGraph & cfg, const std::vector<
 	m_cfg = &cfg.GetT_CFG();
 
 	// Create ENTRY and EXIT vertices.
-	Entry *entry_ptr = new Entry(Location("[" + GetDefinitionFilePath() + " : 0]"));
-	Exit *exit_ptr = new Exit(Location("[" + GetDefinitionFilePath() + " : 0]"));
+	Location definition_file_location(GetDefinitionFilePath(), 0);
+	Entry *entry_ptr = cfg.NewStatement<Entry>(definition_file_location);
+	Exit *exit_ptr = cfg.NewStatement<Exit>(definition_file_location);
 
 	m_entry_vertex_desc = cfg.AddVertex(entry_ptr, this);
 	m_exit_vertex_desc = cfg.AddVertex(exit_ptr, this);
@@ -843,7 +685,7 @@ bool Function::CreateControlFlowGraph(ControlFlowGraph & cfg, const std::vector<
 		if(sbp->IsType<Label>())
 		{
 			// This is a label, add it to the map.
-			Label *lp = dynamic_cast<Label*>(sbp);
+			Label *lp = static_cast<Label*>(sbp);
 			if(label_map.count(lp->GetIdentifier()) != 0)
 			{
 				// There shouldn't be a label with this name already in the map.
@@ -859,7 +701,7 @@ bool Function::CreateControlFlowGraph(ControlFlowGraph & cfg, const std::vector<
 		{
 			// The previous vertex didn't end its basic block.  Therefore, all we have to do is add a simple
 			// fallthrough link to the this vertex.
-			cfg.AddEdge(prev_vertex, vid, new CFGEdgeTypeFallthrough());
+			cfg.AddEdge(prev_vertex, vid, CFGEdgeKind::fallthrough);
 		}
 		else
 		{
@@ -898,7 +740,7 @@ bool Function::CreateControlFlowGraph(ControlFlowGraph & cfg, const std::vector<
 	{
 		// It wasn't, which means it falls through to the EXIT vertex.
 		// Add an edge to the EXIT vertex.
-		cfg.AddEdge(prev_vertex, m_exit_vertex_desc, new CFGEdgeTypeFallthrough());
+		cfg.AddEdge(prev_vertex, m_exit_vertex_desc, CFGEdgeKind::fallthrough);
 	}
 
 	//
@@ -910,7 +752,8 @@ bool Function::CreateControlFlowGraph(ControlFlowGraph & cfg, const std::vector<
 	dlog_cfg << "INFO: Linking FlowControlUnlinked-derived statements." << std::endl;
 	BOOST_FOREACH(T_CFG_VERTEX_DESC vd, list_of_unlinked_flow_control_statements)
 	{
-		FlowControlUnlinked *fcl = dynamic_cast<FlowControlUnlinked*>(cfg.GetStatementPtr(vd));
+		// Only FlowControlUnlinked statements were put on this list.
+		FlowControlUnlinked *fcl = static_cast<FlowControlUnlinked*>(cfg.GetStatementPtr(vd));
 		dlog_cfg << "INFO: Linking " << typeid(*fcl).name() << std::endl;
 		StatementBase* replacement_statement = fcl->ResolveLinks(cfg, vd, label_map);
 
@@ -919,11 +762,10 @@ bool Function::CreateControlFlowGraph(ControlFlowGraph & cfg, const std::vector<
 			// The ResolveLinks call succeeded.  Replace the *Unlinked() class instance with a suitable linked instance.
 			dlog_cfg << "INFO: Linked " << typeid(*fcl).name() << std::endl;
 			cfg.GetT_CFG()[vd].m_statement = replacement_statement;
-			delete fcl;
 		}
 		else
 		{
-			// The ResolveLinks call failed.  Not sure we can do much here, but we won't delete the FlowControlUnlinked object since
+			// The ResolveLinks call failed.  Not sure we can do much here, but we'll leave the FlowControlUnlinked object in place since
 			// we don't have anything to replace it with.
 			dlog_cfg << "ERROR: ResolveLinks() call failed." << std::endl;
 		}
@@ -945,8 +787,8 @@ bool Function::CreateControlFlowGraph(ControlFlowGraph & cfg, const std::vector<
 	dlog_cfg << "INFO: Check complete." << std::endl;
 
 	// Add self edges to the ENTRY and EXIT vertices.
-	m_entry_vertex_self_edge = cfg.AddEdge(m_entry_vertex_desc, m_entry_vertex_desc, new CFGEdgeTypeImpossible);
-	m_exit_vertex_self_edge = cfg.AddEdge(m_exit_vertex_desc, m_exit_vertex_desc, new CFGEdgeTypeImpossible);
+	m_entry_vertex_self_edge = cfg.AddEdge(m_entry_vertex_desc, m_entry_vertex_desc, CFGEdgeKind::impossible);
+	m_exit_vertex_self_edge = cfg.AddEdge(m_exit_vertex_desc, m_exit_vertex_desc, CFGEdgeKind::impossible);
 
 	dlog_cfg << "INFO: Fixing up back edges." << std::endl;
 	cfg.FixupBackEdges(this);
@@ -971,7 +813,7 @@ void Function::AddImpossibleEdges(ControlFlowGraph & cfg, std::vector<BasicBlock
 		}
 
 		// Link it to its immediate predecessor with an Impossible edge.
-		cfg.AddEdge(p.m_immediate_predecessor, p.m_leader, new CFGEdgeTypeImpossible);
+		cfg.AddEdge(p.m_immediate_predecessor, p.m_leader, CFGEdgeKind::impossible);
 	}
 }
 
@@ -0,0 +1,202 @@
+/*
+ * Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+ *
+ * This file is part of CoFlo.
+ *
+ * CoFlo is free software: you can redistribute it and/or modify it under the
+ * terms of version 3 of the GNU General Public License as published by the Free
+ * Software Foundation.
+ *
+ * CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file */
+
+#include "GimpleDumpBuffer.h"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// The empty string the buffer points to when it has no contents.
+static char f_empty_data[1] = { '\0' };
+
+GimpleDumpBuffer::GimpleDumpBuffer()
+{
+	m_mapping = NULL;
+	m_mapping_length = 0;
+	m_data = f_empty_data;
+	m_length = 0;
+}
+
+GimpleDumpBuffer::~GimpleDumpBuffer()
+{
+	Clear();
+}
+
+bool GimpleDumpBuffer::MapFile(const std::string &filename)
+{
+	Clear();
+
+	int fd = open(filename.c_str(), O_RDONLY);
+	if(fd == -1)
+	{
+		std::cerr << "ERROR: Couldn't open file \"" << filename << "\": " << strerror(errno) << std::endl;
+		return false;
+	}
+
+	struct stat file_stat;
+	if(fstat(fd, &file_stat) != 0)
+	{
+		std::cerr << "ERROR: Couldn't stat file \"" << filename << "\": " << strerror(errno) << std::endl;
+		close(fd);
+		return false;
+	}
+	std::size_t file_length = file_stat.st_size;
+
+	// Reserve at least one byte more than the file, rounded up to whole pages, as zero-filled
+	// anonymous memory, then map the file over the start of it.  Whatever's left over past the
+	// end of the file reads as zeros, so the text is always '\0'-terminated, even when the
+	// file's length is an exact multiple of the page size.
+	std::size_t page_size = sysconf(_SC_PAGESIZE);
+	std::size_t mapping_length = ((file_length / page_size) + 1) * page_size;
+
+	void *mapping = mmap(NULL, mapping_length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if(mapping == MAP_FAILED)
+	{
+		std::cerr << "ERROR: Couldn't allocate " << mapping_length << " bytes of address space for \"" << filename << "\": " << strerror(errno) << std::endl;
+		close(fd);
+		return false;
+	}
+
+	if(file_length > 0)
+	{
+		if(mmap(mapping, file_length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED)
+		{
+			std::cerr << "ERROR: Couldn't map file \"" << filename << "\": " << strerror(errno) << std::endl;
+			munmap(mapping, mapping_length);
+			close(fd);
+			return false;
+		}
+	}
+
+	// The mapping holds its own reference to the file.
+	close(fd);
+
+	m_mapping = mapping;
+	m_mapping_length = mapping_length;
+	m_data = static_cast<char*>(mapping);
+	m_length = file_length;
+
+	return true;
+}
+
+void GimpleDumpBuffer::TakeString(std::string *contents)
+{
+	Clear();
+
+	m_string.swap(*contents);
+	m_length = m_string.length();
+
+	// SplitIntoFunctions() writes into the text, so it has to be the string's own, unshared
+	// storage rather than what c_str() returns.  Appending the terminating NUL as an ordinary
+	// character makes sure it's part of that storage too, and non-const operator[] makes the
+	// string unshare its representation, if it's a reference-counted one.
+	m_string.push_back('\0');
+	m_data = &m_string[0];
+}
+
+const char* GimpleDumpBuffer::FindEndOfFunction(const char *begin, const char *end)
+{
+	const char *line_start = begin;
+
+	while(line_start < end)
+	{
+		const char *newline = static_cast<const char*>(memchr(line_start, '\n', end - line_start));
+		const char *line_end = (newline != NULL) ? newline : end;
+		const char *next_line = (newline != NULL) ? newline + 1 : end;
+
+		// Look for a "}" line, allowing for a CRLF line ending.
+		if((line_start[0] == '}') && (((line_end - line_start) == 1)
+				|| ((line_end - line_start) == 2 && line_start[1] == '\r')))
+		{
+			return next_line;
+		}
+
+		line_start = next_line;
+	}
+
+	return NULL;
+}
+
+void GimpleDumpBuffer::SplitIntoFunctions(std::vector< GimpleDumpChunk > *chunks)
+{
+	char *end = m_data + m_length;
+	char *chunk_start = m_data;
+
+	while(chunk_start < end)
+	{
+		char *next_line = const_cast<char*>(FindEndOfFunction(chunk_start, end));
+		if(next_line == NULL)
+		{
+			break;
+		}
+
+		// Found the end of a function.  Skip the blank lines following it.
+		char *next_chunk_start = next_line;
+		while(next_chunk_start < end && strchr(" \t\r\n", *next_chunk_start) != NULL)
+		{
+			++next_chunk_start;
+		}
+
+		GimpleDumpChunk chunk;
+		chunk.m_data = chunk_start;
+		chunk.m_length = next_line - chunk_start;
+		if(next_chunk_start > next_line)
+		{
+			// Terminate the chunk with the first of the blank lines.
+			*next_line = '\0';
+			chunk.m_nul_terminated = true;
+		}
+		else
+		{
+			chunk.m_nul_terminated = (next_line == end);
+		}
+		chunks->push_back(chunk);
+
+		chunk_start = next_chunk_start;
+	}
+
+	if(chunk_start < end)
+	{
+		// Whatever's left over.
+		GimpleDumpChunk chunk;
+		chunk.m_data = chunk_start;
+		chunk.m_length = end - chunk_start;
+		chunk.m_nul_terminated = true;
+		chunks->push_back(chunk);
+	}
+}
+
+void GimpleDumpBuffer::Clear()
+{
+	if(m_mapping != NULL)
+	{
+		munmap(m_mapping, m_mapping_length);
+		m_mapping = NULL;
+		m_mapping_length = 0;
+	}
+	m_string.clear();
+	m_data = f_empty_data;
+	m_length = 0;
+}
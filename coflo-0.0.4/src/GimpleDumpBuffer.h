@@ -0,0 +1,127 @@
+/*
+ * Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+ *
+ * This file is part of CoFlo.
+ *
+ * CoFlo is free software: you can redistribute it and/or modify it under the
+ * terms of version 3 of the GNU General Public License as published by the Free
+ * Software Foundation.
+ *
+ * CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file */
+
+#ifndef GIMPLEDUMPBUFFER_H
+#define GIMPLEDUMPBUFFER_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+/**
+ * One top-level function definition's worth of the text in a GimpleDumpBuffer.
+ */
+struct GimpleDumpChunk
+{
+	/// The start of the chunk.
+	char *m_data;
+
+	/// The length of the chunk, in bytes.
+	std::size_t m_length;
+
+	/// true if m_data[m_length] is a NUL.
+	bool m_nul_terminated;
+};
+
+/**
+ * The in-memory text of a GIMPLE dump, ready to be handed to the parser.
+ *
+ * The text either comes from a file, which is memory-mapped rather than read in, or is
+ * taken over from a std::string.  Either way, the text is followed by a NUL which isn't
+ * counted in GetLength(), and it may contain CR's, which the parser treats as whitespace.
+ */
+class GimpleDumpBuffer : boost::noncopyable
+{
+public:
+	GimpleDumpBuffer();
+	~GimpleDumpBuffer();
+
+	/**
+	 * Map the file @a filename into memory.  Any previous contents are released.
+	 *
+	 * The mapping is private, so changes made through GetData() are never written back to
+	 * the file, and the file may be deleted while the mapping is still in use.
+	 *
+	 * @param filename The file to map.
+	 * @return true on success, false if the file couldn't be mapped.
+	 */
+	bool MapFile(const std::string &filename);
+
+	/**
+	 * Take over the contents of @a contents, leaving it empty.  Any previous contents are released.
+	 *
+	 * @param contents The text of the dump.
+	 */
+	void TakeString(std::string *contents);
+
+	/// Release the current contents, leaving the buffer empty.
+	void Clear();
+
+	/**
+	 * Split the text into chunks of one top-level function definition each, in the order
+	 * they appear.
+	 *
+	 * A function definition ends at a line consisting of just a '}', as found by
+	 * FindEndOfFunction(); the scopes nested inside it are always indented.  Any text which doesn't end that way ends up in the last chunk.
+	 * So the chunks don't have to be copied out, the blank line following each chunk is
+	 * overwritten with a NUL to terminate it in place, which means the text is no longer
+	 * usable as a whole afterwards.
+	 *
+	 * @param[out] chunks The vector to append the chunks to.
+	 */
+	void SplitIntoFunctions(std::vector< GimpleDumpChunk > *chunks);
+
+	/**
+	 * Find the end of the top-level function definition starting at @a begin, i.e. the end of
+	 * the first line consisting of just a '}'.
+	 *
+	 * @param begin The start of the text to search.
+	 * @param end The end of the text to search.
+	 * @return A pointer just past the end of the "}" line, or NULL if there isn't one.
+	 */
+	static const char* FindEndOfFunction(const char *begin, const char *end);
+
+	/// @name Accessors
+	//@{
+	char* GetData() { return m_data; };
+	const char* GetData() const { return m_data; };
+	std::size_t GetLength() const { return m_length; };
+	//@}
+
+private:
+
+	/// The memory-mapped region, or NULL if the contents aren't mapped.
+	void *m_mapping;
+
+	/// The length of m_mapping, in bytes.
+	std::size_t m_mapping_length;
+
+	/// The contents followed by a NUL, if they were taken over from a string.
+	std::string m_string;
+
+	/// The start of the text, either in m_mapping or m_string.
+	char *m_data;
+
+	/// The length of the text, not counting the terminating NUL.
+	std::size_t m_length;
+};
+
+#endif /* GIMPLEDUMPBUFFER_H */
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+ *
+ * This file is part of CoFlo.
+ *
+ * CoFlo is free software: you can redistribute it and/or modify it under the
+ * terms of version 3 of the GNU General Public License as published by the Free
+ * Software Foundation.
+ *
+ * CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file */
+
+#include "GimpleDumpCache.h"
+
+#include <cstdio>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <boost/uuid/sha1.hpp>
+
+#include "debug_utils/debug_utils.hpp"
+
+#include "libexttools/ToolBase.h"
+
+/// Bump this whenever a change to CoFlo changes the dumps it asks gcc for, so that stale
+/// cache entries aren't used.
+static const char f_cache_format_version[] = "1";
+
+/**
+ * Add a length-prefixed field to the hash.  The length prefix keeps e.g. ("ab","c") and
+ * ("a","bc") from hashing to the same value.
+ */
+static void HashField(boost::uuids::detail::sha1 *hasher, const std::string &field)
+{
+	std::ostringstream length;
+	length << field.size() << ":";
+	hasher->process_bytes(length.str().data(), length.str().size());
+	hasher->process_bytes(field.data(), field.size());
+}
+
+GimpleDumpCache::GimpleDumpCache(const boost::filesystem::path &cache_dir)
+{
+	m_cache_dir = cache_dir;
+
+	boost::system::error_code ec;
+	boost::filesystem::create_directories(m_cache_dir, ec);
+	if(ec)
+	{
+		std::cerr << "ERROR: Couldn't create cache directory \"" << m_cache_dir.generic_string() << "\": " << ec.message() << std::endl;
+	}
+}
+
+GimpleDumpCache::~GimpleDumpCache()
+{
+}
+
+std::string GimpleDumpCache::MakeKey(const std::string &preprocessed_source,
+		const std::string &params,
+		const std::string &the_filter,
+		const std::string &compiler_cmd,
+		const std::string &compiler_version)
+{
+	boost::uuids::detail::sha1 hasher;
+
+	HashField(&hasher, f_cache_format_version);
+	HashField(&hasher, compiler_cmd);
+	HashField(&hasher, compiler_version);
+	HashField(&hasher, the_filter);
+	HashField(&hasher, params);
+	HashField(&hasher, preprocessed_source);
+
+	unsigned int digest[5];
+	hasher.get_digest(digest);
+
+	std::ostringstream key;
+	key << std::hex << std::setfill('0');
+	for(int i=0; i<5; ++i)
+	{
+		key << std::setw(8) << digest[i];
+	}
+
+	return key.str();
+}
+
+bool GimpleDumpCache::Lookup(const std::string &key, boost::filesystem::path *dump_path) const
+{
+	boost::filesystem::path entry_path = GetEntryPath(key);
+	boost::system::error_code ec;
+
+	if(!boost::filesystem::is_regular_file(entry_path, ec))
+	{
+		dlog_parse_gimple << "Dump cache miss: " << key << std::endl;
+		return false;
+	}
+
+	dlog_parse_gimple << "Dump cache hit: " << key << std::endl;
+	*dump_path = entry_path;
+	return true;
+}
+
+bool GimpleDumpCache::Store(const std::string &key, const char *dump_contents, std::size_t dump_length) const
+{
+	boost::system::error_code ec;
+
+	// Write to a temporary file in the cache directory first, then rename it into place.  The
+	// rename is atomic, so anyone else looking up this key sees either no entry or a complete one.
+	std::string temp_path = ToolBase::Mktemp((m_cache_dir / "coflo-cache.XXXXXX").generic_string());
+	if(temp_path.empty())
+	{
+		return false;
+	}
+
+	{
+		std::ofstream temp_file(temp_path.c_str(), std::ios::binary | std::ios::trunc);
+
+		temp_file.write(dump_contents, dump_length);
+		temp_file.close();
+
+		if(temp_file.fail())
+		{
+			std::cerr << "ERROR: Couldn't write \"" << temp_path << "\" to the dump cache." << std::endl;
+			boost::filesystem::remove(temp_path, ec);
+			return false;
+		}
+	}
+
+	if(rename(temp_path.c_str(), GetEntryPath(key).generic_string().c_str()) != 0)
+	{
+		std::cerr << "ERROR: Couldn't add \"" << GetEntryPath(key).generic_string() << "\" to the dump cache." << std::endl;
+		boost::filesystem::remove(temp_path, ec);
+		return false;
+	}
+
+	return true;
+}
+
+boost::filesystem::path GimpleDumpCache::GetEntryPath(const std::string &key) const
+{
+	return m_cache_dir / (key + ".coflo.gimple");
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+ *
+ * This file is part of CoFlo.
+ *
+ * CoFlo is free software: you can redistribute it and/or modify it under the
+ * terms of version 3 of the GNU General Public License as published by the Free
+ * Software Foundation.
+ *
+ * CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file */
+
+#ifndef GIMPLEDUMPCACHE_H
+#define GIMPLEDUMPCACHE_H
+
+#include <cstddef>
+#include <string>
+
+#include <boost/filesystem.hpp>
+
+/**
+ * A persistent, content-addressed on-disk cache of the GIMPLE dumps gcc generates for us.
+ *
+ * Entries are keyed on a hash of everything which can affect the dump: the preprocessed
+ * source text, the parameters passed to the compiler, the filter command, and the compiler
+ * command and version.  Since the preprocessed source includes the contents of every header
+ * the file pulls in, a change to any of them results in a different key.
+ *
+ * Lookups and stores may be performed concurrently, from multiple threads or multiple
+ * CoFlo processes sharing the same cache directory.
+ */
+class GimpleDumpCache
+{
+public:
+	/**
+	 * Constructor.
+	 *
+	 * @param cache_dir The directory to keep the cached dumps in.  Created if it doesn't exist.
+	 */
+	GimpleDumpCache(const boost::filesystem::path &cache_dir);
+	virtual ~GimpleDumpCache();
+
+	/**
+	 * Compute the cache key for a compile.
+	 *
+	 * @param preprocessed_source The output of the preprocessor for the source file.
+	 * @param params The -D/-I parameters to be passed to the compiler.
+	 * @param the_filter The filter command.
+	 * @param compiler_cmd The compiler command.
+	 * @param compiler_version The compiler's version string.
+	 * @return The key, as a string of hex digits.
+	 */
+	static std::string MakeKey(const std::string &preprocessed_source,
+			const std::string &params,
+			const std::string &the_filter,
+			const std::string &compiler_cmd,
+			const std::string &compiler_version);
+
+	/**
+	 * Look up a cached dump.
+	 *
+	 * @param key The key returned by MakeKey().
+	 * @param[out] dump_path The path of the cached dump, if there is one.
+	 * @return true on a cache hit, false on a miss.
+	 */
+	bool Lookup(const std::string &key, boost::filesystem::path *dump_path) const;
+
+	/**
+	 * Add a dump to the cache.
+	 *
+	 * @param key The key returned by MakeKey().
+	 * @param dump_contents The contents of the dump.
+	 * @param dump_length The length of @a dump_contents, in bytes.
+	 * @return true on success, false if the dump couldn't be stored.
+	 */
+	bool Store(const std::string &key, const char *dump_contents, std::size_t dump_length) const;
+
+private:
+
+	/// Return the path at which the dump with the given @a key is stored.
+	boost::filesystem::path GetEntryPath(const std::string &key) const;
+
+	/// The directory the cache lives in.
+	boost::filesystem::path m_cache_dir;
+};
+
+#endif /* GIMPLEDUMPCACHE_H */
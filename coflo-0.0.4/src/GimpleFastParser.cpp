@@ -0,0 +1,1148 @@
+/*
+ * Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+ *
+ * This file is part of CoFlo.
+ *
+ * CoFlo is free software: you can redistribute it and/or modify it under the
+ * terms of version 3 of the GNU General Public License as published by the Free
+ * Software Foundation.
+ *
+ * CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file */
+
+#include "GimpleFastParser.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "Location.h"
+#include "ParseArena.h"
+#include "controlflowgraph/statements/statements.h"
+#include "controlflowgraph/statements/ParseHelpers.h"
+#include "debug_utils/debug_utils.hpp"
+
+/// @name Scanners for the individual tokens.
+/// Each takes a pointer to the current position in the text, which it advances past whatever
+/// it recognized.  They return false, without advancing, if they didn't recognize anything.
+//@{
+
+static bool IsIdentifierStart(char c)
+{
+	return isalpha(static_cast<unsigned char>(c)) || c == '_';
+}
+
+static bool IsIdentifierChar(char c)
+{
+	return isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+static bool IsDigit(char c)
+{
+	return isdigit(static_cast<unsigned char>(c));
+}
+
+static void SkipWhitespace(const char **p, const char *e)
+{
+	while(*p < e && (**p == ' ' || **p == '\t' || **p == '\r'))
+	{
+		++(*p);
+	}
+}
+
+static bool IsBlank(const char *p, const char *e)
+{
+	SkipWhitespace(&p, e);
+	return p == e;
+}
+
+/// Match the keyword @a keyword, which must not be followed by any identifier characters.
+static bool ScanKeyword(const char **p, const char *e, const char *keyword)
+{
+	std::size_t length = strlen(keyword);
+	if((static_cast<std::size_t>(e - *p) < length) || (strncmp(*p, keyword, length) != 0)
+			|| ((*p + length < e) && IsIdentifierChar((*p)[length])))
+	{
+		return false;
+	}
+	*p += length;
+	return true;
+}
+
+static bool ScanChar(const char **p, const char *e, char c)
+{
+	if(*p == e || **p != c)
+	{
+		return false;
+	}
+	++(*p);
+	return true;
+}
+
+static bool ScanInteger(const char **p, const char *e, long *value)
+{
+	const char *q = *p;
+	while(q < e && IsDigit(*q))
+	{
+		++q;
+	}
+	if(q == *p)
+	{
+		return false;
+	}
+	*value = atol(std::string(*p, q).c_str());
+	*p = q;
+	return true;
+}
+
+/**
+ * Match an identifier, or if @a allow_ssa is true, an SSA name such as "D.1234" as well.
+ */
+static bool ScanIdentifier(const char **p, const char *e, bool allow_ssa, std::string *identifier)
+{
+	const char *q = *p;
+	if(q == e || !IsIdentifierStart(*q))
+	{
+		return false;
+	}
+	while(q < e && IsIdentifierChar(*q))
+	{
+		++q;
+	}
+	if(allow_ssa && (q + 1 < e) && *q == '.' && IsDigit(q[1]))
+	{
+		++q;
+		while(q < e && IsDigit(*q))
+		{
+			++q;
+		}
+	}
+	identifier->assign(*p, q);
+	*p = q;
+	return true;
+}
+
+/// Match a compiler-generated label such as "<D.1234>".
+static bool ScanSyntheticLabel(const char **p, const char *e, std::string *label)
+{
+	const char *q = *p;
+	std::string identifier;
+	if(!ScanChar(&q, e, '<') || !ScanIdentifier(&q, e, true, &identifier)
+			|| identifier.find('.') == std::string::npos || !ScanChar(&q, e, '>'))
+	{
+		return false;
+	}
+	*label = "<" + identifier + ">";
+	*p = q;
+	return true;
+}
+
+/// Match a location prefix, e.g. "[file.c : 12:3]".
+static bool ScanLocation(const char **p, const char *e, Location *location)
+{
+	const char *q = *p;
+	if(!ScanChar(&q, e, '['))
+	{
+		return false;
+	}
+	SkipWhitespace(&q, e);
+
+	const char *path_begin = q;
+	while(q < e && (IsIdentifierChar(*q) || strchr(".-\\/", *q) != NULL))
+	{
+		++q;
+	}
+	const char *path_end = q;
+
+	long line, column;
+	SkipWhitespace(&q, e);
+	if(path_begin == path_end || !ScanChar(&q, e, ':'))
+	{
+		return false;
+	}
+	SkipWhitespace(&q, e);
+	if(!ScanInteger(&q, e, &line))
+	{
+		return false;
+	}
+	SkipWhitespace(&q, e);
+	bool has_column = ScanChar(&q, e, ':');
+	if(has_column)
+	{
+		SkipWhitespace(&q, e);
+		if(!ScanInteger(&q, e, &column))
+		{
+			return false;
+		}
+		SkipWhitespace(&q, e);
+	}
+	if(!ScanChar(&q, e, ']'))
+	{
+		return false;
+	}
+
+	if(has_column)
+	{
+		*location = Location(std::string(path_begin, path_end), line, column);
+	}
+	else
+	{
+		*location = Location(std::string(path_begin, path_end), line);
+	}
+	*p = q;
+	return true;
+}
+
+/**
+ * Skip from the @a open character at *p to just past the matching @a close character,
+ * ignoring any in string literals.
+ */
+static bool ScanBalanced(const char **p, const char *e, char open, char close)
+{
+	const char *q = *p;
+	int depth = 0;
+	while(q < e)
+	{
+		char c = *q;
+		++q;
+		if(c == '"')
+		{
+			// Skip the string literal.
+			while(q < e && *q != '"')
+			{
+				if(*q == '\\')
+				{
+					++q;
+				}
+				++q;
+			}
+			if(q >= e)
+			{
+				return false;
+			}
+			++q;
+		}
+		else if(c == open)
+		{
+			++depth;
+		}
+		else if(c == close)
+		{
+			--depth;
+			if(depth == 0)
+			{
+				*p = q;
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+/// Returns the text from @a begin to @a end, minus any leading or trailing whitespace.
+static std::string TrimmedString(const char *begin, const char *end)
+{
+	SkipWhitespace(&begin, end);
+	while(end > begin && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r'))
+	{
+		--end;
+	}
+	return std::string(begin, end);
+}
+
+/**
+ * Match the end of a single-line statement: a ';', possibly followed by some bracketed text
+ * such as "[tail call]", and then the end of the line.
+ */
+static bool ScanEndOfStatement(const char *p, const char *e)
+{
+	SkipWhitespace(&p, e);
+	if(!ScanChar(&p, e, ';'))
+	{
+		return false;
+	}
+	SkipWhitespace(&p, e);
+	if(p < e && *p == '[')
+	{
+		const char *close = static_cast<const char*>(memchr(p, ']', e - p));
+		if(close == NULL || close == p + 1)
+		{
+			return false;
+		}
+		p = close + 1;
+	}
+	return IsBlank(p, e);
+}
+
+/// @name Scanners for the expressions on the right-hand side of assignments.
+/// These only accept what the assignment_statement_internals rule of the dparser grammar
+/// does, so that the fast parser gives up on anything else and dparser gets to reject it.
+//@{
+
+/// Skip any number of location prefixes, and the whitespace following them.
+static bool SkipLocations(const char **p, const char *e)
+{
+	Location location;
+	bool found_any = false;
+	SkipWhitespace(p, e);
+	while(*p < e && **p == '[' && ScanLocation(p, e, &location))
+	{
+		found_any = true;
+		SkipWhitespace(p, e);
+	}
+	return found_any;
+}
+
+/// Match a var_id: an identifier, an SSA name, or "<retval>".
+static bool ScanVarId(const char **p, const char *e)
+{
+	std::string identifier;
+	if(e - *p >= 8 && strncmp(*p, "<retval>", 8) == 0)
+	{
+		*p += 8;
+		return true;
+	}
+	return ScanIdentifier(p, e, true, &identifier);
+}
+
+/// Match a constant: a decimal, hex or floating point number, or "<<< error >>>".
+static bool ScanConstant(const char **p, const char *e)
+{
+	const char *q = *p;
+	if(e - q >= 13 && strncmp(q, "<<< error >>>", 13) == 0)
+	{
+		*p = q + 13;
+		return true;
+	}
+	if(e - q >= 3 && q[0] == '0' && q[1] == 'x' && isxdigit(static_cast<unsigned char>(q[2])))
+	{
+		q += 2;
+		while(q < e && isxdigit(static_cast<unsigned char>(*q)))
+		{
+			++q;
+		}
+	}
+	else
+	{
+		bool is_signed = (q < e && (*q == '-' || *q == '+'));
+		if(is_signed)
+		{
+			++q;
+		}
+		const char *digits = q;
+		while(q < e && IsDigit(*q))
+		{
+			++q;
+		}
+		if(q == digits)
+		{
+			return false;
+		}
+		if(q + 1 < e && *q == '.' && IsDigit(q[1]))
+		{
+			// Floating point.  These are never signed.
+			if(is_signed)
+			{
+				return false;
+			}
+			++q;
+			while(q < e && IsDigit(*q))
+			{
+				++q;
+			}
+			if(q + 2 < e && *q == 'e' && (q[1] == '+' || q[1] == '-') && IsDigit(q[2]))
+			{
+				q += 2;
+				while(q < e && IsDigit(*q))
+				{
+					++q;
+				}
+			}
+		}
+		else
+		{
+			// Decimal integers have no leading zeros, and may have a 'B' suffix.
+			if(*digits == '0' && q - digits > 1)
+			{
+				return false;
+			}
+			if(q < e && *q == 'B')
+			{
+				++q;
+			}
+		}
+	}
+	if(q < e && IsIdentifierChar(*q))
+	{
+		return false;
+	}
+	*p = q;
+	return true;
+}
+
+static bool ScanVarOrConstant(const char **p, const char *e)
+{
+	return ScanConstant(p, e) || ScanVarId(p, e);
+}
+
+static bool ScanStringLiteral(const char **p, const char *e)
+{
+	const char *q = *p;
+	if(!ScanChar(&q, e, '"'))
+	{
+		return false;
+	}
+	while(q < e && *q != '"')
+	{
+		q += (*q == '\\') ? 2 : 1;
+	}
+	if(q >= e)
+	{
+		return false;
+	}
+	*p = q + 1;
+	return true;
+}
+
+/// Skip any ".field", "->field" and "[index]" suffixes.
+static bool ScanAccessSuffixes(const char **p, const char *e)
+{
+	const char *q = *p;
+	std::string identifier;
+	while(true)
+	{
+		const char *suffix = q;
+		SkipWhitespace(&q, e);
+		if(ScanChar(&q, e, '.'))
+		{
+			SkipWhitespace(&q, e);
+			if(!ScanVarId(&q, e))
+			{
+				return false;
+			}
+		}
+		else if(e - q >= 2 && q[0] == '-' && q[1] == '>')
+		{
+			q += 2;
+			SkipWhitespace(&q, e);
+			if(!ScanIdentifier(&q, e, false, &identifier))
+			{
+				return false;
+			}
+		}
+		else if(ScanChar(&q, e, '['))
+		{
+			SkipWhitespace(&q, e);
+			if(!ScanVarOrConstant(&q, e))
+			{
+				return false;
+			}
+			SkipWhitespace(&q, e);
+			if(!ScanChar(&q, e, ']'))
+			{
+				return false;
+			}
+		}
+		else
+		{
+			*p = suffix;
+			return true;
+		}
+	}
+}
+
+/// Match an lhs, e.g. "x", "*p" or "s.a[i]", with any location prefixes.
+static bool ScanLhs(const char **p, const char *e)
+{
+	const char *q = *p;
+	SkipLocations(&q, e);
+	if(ScanChar(&q, e, '*'))
+	{
+		SkipWhitespace(&q, e);
+	}
+	if(!ScanVarId(&q, e) || !ScanAccessSuffixes(&q, e))
+	{
+		return false;
+	}
+	*p = q;
+	return true;
+}
+
+/// Match an rhs, e.g. "x", "1", "*p", "&s.a" or a string literal, with any location prefixes.
+static bool ScanRhs(const char **p, const char *e)
+{
+	const char *q = *p;
+	bool has_location = SkipLocations(&q, e);
+	if(ScanChar(&q, e, '*') || (has_location && ScanChar(&q, e, '&')))
+	{
+		if(!ScanRhs(&q, e))
+		{
+			return false;
+		}
+	}
+	else if(!ScanStringLiteral(&q, e) && !ScanConstant(&q, e) && !ScanVarId(&q, e))
+	{
+		return false;
+	}
+	if(!ScanAccessSuffixes(&q, e))
+	{
+		return false;
+	}
+	*p = q;
+	return true;
+}
+
+/// Match one of the NUL-terminated strings in @a operators, trying them in order.
+static bool ScanOperator(const char **p, const char *e, const char * const *operators)
+{
+	for(; *operators != NULL; ++operators)
+	{
+		std::size_t length = strlen(*operators);
+		if(static_cast<std::size_t>(e - *p) >= length && strncmp(*p, *operators, length) == 0)
+		{
+			*p += length;
+			return true;
+		}
+	}
+	return false;
+}
+
+/// The bitwise and arithmetic binary operators, longest first.
+static const char * const f_binary_operators[] = { ">>", "<<", "r<<", "|", "&", "^", "+", "-", "*", "/", "%", NULL };
+
+/// The comparison operators, longest first.
+static const char * const f_comparison_operators[] = { ">=", "<=", "==", "!=", ">", "<", NULL };
+
+/// Match a cast's "(type)", which may only contain what a decl_spec can.
+static bool ScanCast(const char **p, const char *e)
+{
+	const char *q = *p;
+	if(q == e || *q != '(' || !ScanBalanced(&q, e, '(', ')'))
+	{
+		return false;
+	}
+	for(const char *c = *p + 1; c < q - 1; ++c)
+	{
+		if(!IsIdentifierChar(*c) && strchr(" \t*[]<>(),", *c) == NULL)
+		{
+			return false;
+		}
+	}
+	*p = q;
+	return true;
+}
+
+/**
+ * Returns true if the text from @a p to @a e is the right-hand side of an assignment which
+ * the dparser grammar turns into a Placeholder, i.e. anything but a function call.
+ */
+static bool IsPlaceholderRhs(const char *p, const char *e)
+{
+	const char *q = p;
+	SkipWhitespace(&q, e);
+
+	const char *operand = q;
+	if(ScanChar(&operand, e, '~') || ScanChar(&operand, e, '-'))
+	{
+		// Unary operators.  A '-' may also be the sign of a constant on the left of a binary
+		// operator, which is handled below.
+		SkipWhitespace(&operand, e);
+		if(ScanRhs(&operand, e) && IsBlank(operand, e))
+		{
+			return true;
+		}
+	}
+
+	if(ScanCast(&q, e))
+	{
+		SkipWhitespace(&q, e);
+		const char *literal = q;
+		if(ScanChar(&literal, e, '&'))
+		{
+			// A string literal's address, cast.
+			SkipWhitespace(&literal, e);
+			if(!ScanStringLiteral(&literal, e))
+			{
+				return false;
+			}
+			SkipWhitespace(&literal, e);
+			if(!ScanChar(&literal, e, '['))
+			{
+				return false;
+			}
+			SkipWhitespace(&literal, e);
+			if(!ScanConstant(&literal, e))
+			{
+				return false;
+			}
+			SkipWhitespace(&literal, e);
+			return ScanChar(&literal, e, ']') && IsBlank(literal, e);
+		}
+		return ScanRhs(&q, e) && IsBlank(q, e);
+	}
+
+	if(ScanKeyword(&q, e, "MIN_EXPR") || ScanKeyword(&q, e, "MAX_EXPR"))
+	{
+		// MIN_EXPR <a, b>
+		SkipWhitespace(&q, e);
+		if(!ScanChar(&q, e, '<'))
+		{
+			return false;
+		}
+		SkipWhitespace(&q, e);
+		if(!ScanChar(&q, e, '>'))
+		{
+			do
+			{
+				SkipWhitespace(&q, e);
+				if(!ScanRhs(&q, e))
+				{
+					return false;
+				}
+				SkipWhitespace(&q, e);
+			} while(ScanChar(&q, e, ','));
+			if(!ScanChar(&q, e, '>'))
+			{
+				return false;
+			}
+		}
+		return IsBlank(q, e);
+	}
+
+	const char *bit_field_ref = q;
+	if(SkipLocations(&bit_field_ref, e) && ScanKeyword(&bit_field_ref, e, "BIT_FIELD_REF"))
+	{
+		// [location] BIT_FIELD_REF <rhs, constant, constant>
+		q = bit_field_ref;
+		SkipWhitespace(&q, e);
+		if(!ScanChar(&q, e, '<') || !ScanRhs(&q, e))
+		{
+			return false;
+		}
+		for(int i = 0; i < 2; ++i)
+		{
+			SkipWhitespace(&q, e);
+			if(!ScanChar(&q, e, ','))
+			{
+				return false;
+			}
+			SkipWhitespace(&q, e);
+			if(!ScanConstant(&q, e))
+			{
+				return false;
+			}
+		}
+		SkipWhitespace(&q, e);
+		return ScanChar(&q, e, '>') && IsBlank(q, e);
+	}
+
+	// A plain rhs, or two of them with an operator in between.  Only a plain var_id or
+	// constant can be on the left of a comparison.
+	const char *plain_operand_end = q;
+	bool is_plain = ScanVarOrConstant(&plain_operand_end, e);
+	if(!ScanRhs(&q, e))
+	{
+		return false;
+	}
+	is_plain = is_plain && (plain_operand_end == q);
+	SkipWhitespace(&q, e);
+	if(q == e)
+	{
+		return true;
+	}
+	if(!ScanOperator(&q, e, f_binary_operators)
+			&& !(is_plain && ScanOperator(&q, e, f_comparison_operators)))
+	{
+		return false;
+	}
+	SkipWhitespace(&q, e);
+	return ScanRhs(&q, e) && IsBlank(q, e);
+}
+
+//@}
+
+/**
+ * Returns true if the line looks like a declaration rather than a statement: it ends in a
+ * ';', and doesn't start with anything a statement can start with.
+ */
+static bool IsDeclarationLike(const char *p, const char *e)
+{
+	SkipWhitespace(&p, e);
+	const char *last = e;
+	while(last > p && (last[-1] == ' ' || last[-1] == '\t' || last[-1] == '\r'))
+	{
+		--last;
+	}
+	if(p == last || last[-1] != ';' || strchr("[<{}", *p) != NULL)
+	{
+		return false;
+	}
+	const char *q = p;
+	if(ScanKeyword(&q, e, "goto") || ScanKeyword(&q, e, "return") || ScanKeyword(&q, e, "if")
+			|| ScanKeyword(&q, e, "switch"))
+	{
+		return false;
+	}
+	return true;
+}
+
+//@}
+
+GimpleFastParser::GimpleFastParser(ParseArena *arena)
+{
+	m_arena = arena;
+	m_pos = NULL;
+	m_previous_line = NULL;
+	m_end = NULL;
+}
+
+GimpleFastParser::~GimpleFastParser()
+{
+}
+
+FunctionInfo* GimpleFastParser::ParseFunction(const char *begin, const char *end)
+{
+	m_pos = begin;
+	m_previous_line = begin;
+	m_end = end;
+
+	// The arena's statements all end up in the ControlFlowGraph, so if we give up, the ones we
+	// created for this function have to go before the caller parses it some other way.
+	ObjectArena::Mark mark = m_arena->GetStatementArena()->GetMark();
+
+	FunctionInfo *function_info = NULL;
+	if(!ParseFunctionDefinition(&function_info))
+	{
+		m_arena->GetStatementArena()->RollBack(mark);
+		function_info = NULL;
+	}
+
+	return function_info;
+}
+
+bool GimpleFastParser::NextLine(const char **line_begin, const char **line_end)
+{
+	if(m_pos >= m_end)
+	{
+		return false;
+	}
+
+	const char *newline = static_cast<const char*>(memchr(m_pos, '\n', m_end - m_pos));
+	*line_begin = m_pos;
+	*line_end = (newline != NULL) ? newline : m_end;
+	if(*line_end > *line_begin && (*line_end)[-1] == '\r')
+	{
+		--(*line_end);
+	}
+
+	m_previous_line = m_pos;
+	m_pos = (newline != NULL) ? newline + 1 : m_end;
+	return true;
+}
+
+bool GimpleFastParser::ParseFunctionDefinition(FunctionInfo **function_info)
+{
+	const char *b, *e, *p;
+
+	// The "name (params)" line.  Only the C style is handled, C++ functions are left to dparser.
+	std::string identifier;
+	if(!NextLine(&b, &e))
+	{
+		return false;
+	}
+	p = b;
+	if(!ScanIdentifier(&p, e, false, &identifier))
+	{
+		return false;
+	}
+	SkipWhitespace(&p, e);
+	if(p == e || *p != '(' || !ScanBalanced(&p, e, '(', ')') || !IsBlank(p, e))
+	{
+		return false;
+	}
+
+	// The "[location] {" line.
+	Location location;
+	if(!NextLine(&b, &e))
+	{
+		return false;
+	}
+	p = b;
+	SkipWhitespace(&p, e);
+	if(p < e && *p == '[' && !ScanLocation(&p, e, &location))
+	{
+		return false;
+	}
+	SkipWhitespace(&p, e);
+	if(!ScanChar(&p, e, '{') || !IsBlank(p, e))
+	{
+		return false;
+	}
+
+	FunctionInfo *fi = m_arena->NewFunctionInfo();
+	fi->m_location = m_arena->NewLocation(location);
+	fi->m_identifier = m_arena->NewString(identifier);
+	fi->m_statement_list = m_arena->NewStatementList();
+
+	if(!ParseScopeBody(fi->m_statement_list, true))
+	{
+		return false;
+	}
+
+	// The closing "}" should have been the last line.
+	if(m_pos != m_end)
+	{
+		return false;
+	}
+
+	*function_info = fi;
+	return true;
+}
+
+bool GimpleFastParser::ParseScopeBody(StatementList *statement_list, bool is_function_body)
+{
+	bool found_declarations = false;
+	if(!ParseDeclarations(&found_declarations))
+	{
+		return false;
+	}
+
+	// The declarations are followed by a blank line.  Nested scopes always have the blank
+	// line, even when they have no declarations.
+	if(found_declarations || !is_function_body)
+	{
+		const char *b, *e;
+		if(!NextLine(&b, &e) || !IsBlank(b, e))
+		{
+			return false;
+		}
+	}
+
+	return ParseStatementList(statement_list, is_function_body);
+}
+
+bool GimpleFastParser::ParseDeclarations(bool *found_any)
+{
+	// We don't need anything out of the declarations, so all we do is skip them.
+	const char *b, *e;
+	*found_any = false;
+	while(NextLine(&b, &e))
+	{
+		if(!IsDeclarationLike(b, e))
+		{
+			PutBackLine();
+			break;
+		}
+		*found_any = true;
+	}
+	return true;
+}
+
+bool GimpleFastParser::ParseStatementList(StatementList *statement_list, bool is_function_body)
+{
+	const char *b, *e;
+	while(NextLine(&b, &e))
+	{
+		const char *p = b;
+		SkipWhitespace(&p, e);
+		if(p == e)
+		{
+			// Blank lines don't occur in statement lists.
+			return false;
+		}
+
+		if(*p == '}' && IsBlank(p + 1, e))
+		{
+			// The end of the scope.  The function body's closing brace is in column 0, those
+			// of nested scopes never are.
+			return (p == b) == is_function_body;
+		}
+
+		if(!ParseStatement(p, e, statement_list))
+		{
+			return false;
+		}
+	}
+
+	return false;
+}
+
+bool GimpleFastParser::ParseStatement(const char *p, const char *e, StatementList *statement_list)
+{
+	Location location;
+	bool has_location = false;
+
+	if(*p == '[')
+	{
+		if(!ScanLocation(&p, e, &location))
+		{
+			return false;
+		}
+		has_location = true;
+		SkipWhitespace(&p, e);
+	}
+
+	if(p == e)
+	{
+		return false;
+	}
+
+	// A nested scope.  Its statements are simply added to ours.
+	if(*p == '{')
+	{
+		return IsBlank(p + 1, e) && ParseScopeBody(statement_list, false);
+	}
+
+	// A "comment statement".
+	if(e - p > 2 && p[0] == '/' && p[1] == '/')
+	{
+		dlog_parse_gimple << "Ignoring comment" << std::endl;
+		statement_list->push_back(m_arena->NewStatement<NoOp>(Location()));
+		return true;
+	}
+
+	const char *q = p;
+	if(ScanKeyword(&q, e, "if"))
+	{
+		return ParseIf(location, p, e, statement_list);
+	}
+
+	if(ScanKeyword(&q, e, "goto"))
+	{
+		GotoUnlinked *goto_statement;
+		q = p;
+		if(!ParseGoto(location, &q, e, &goto_statement))
+		{
+			return false;
+		}
+		statement_list->push_back(goto_statement);
+		return ScanEndOfStatement(q, e);
+	}
+
+	if(ScanKeyword(&q, e, "return"))
+	{
+		std::string return_var;
+		SkipWhitespace(&q, e);
+		if(q < e && *q != ';')
+		{
+			if(e - q >= 8 && strncmp(q, "<retval>", 8) == 0)
+			{
+				return_var = "<retval>";
+				q += 8;
+			}
+			else if(!ScanIdentifier(&q, e, true, &return_var))
+			{
+				return false;
+			}
+		}
+		statement_list->push_back(m_arena->NewStatement<ReturnUnlinked>(location, return_var));
+		return ScanEndOfStatement(q, e);
+	}
+
+	if(ScanKeyword(&q, e, "switch"))
+	{
+		// Not handled here.
+		return false;
+	}
+
+	// A label.
+	std::string label;
+	q = p;
+	if(ScanSyntheticLabel(&q, e, &label) || ScanIdentifier(&q, e, false, &label))
+	{
+		SkipWhitespace(&q, e);
+		if(ScanChar(&q, e, ':') && (q == e || *q != ':'))
+		{
+			SkipWhitespace(&q, e);
+			ScanChar(&q, e, ';');
+			if(!IsBlank(q, e))
+			{
+				return false;
+			}
+			statement_list->push_back(m_arena->NewStatement<Label>(location, label));
+			return true;
+		}
+	}
+
+	// A function call whose return value isn't used.
+	StatementBase *call;
+	if(ParseCall(location, p, e, &call))
+	{
+		statement_list->push_back(call);
+		return true;
+	}
+
+	// An assignment.  These always have a location.
+	const char *equals = NULL;
+	for(q = p; q + 3 <= e; ++q)
+	{
+		if(q[0] == ' ' && q[1] == '=' && q[2] == ' ')
+		{
+			equals = q;
+			break;
+		}
+	}
+	if(!has_location || equals == NULL || equals == p)
+	{
+		return false;
+	}
+	q = p;
+	if(!ScanLhs(&q, equals) || !IsBlank(q, equals))
+	{
+		return false;
+	}
+
+	// If the right-hand side is a function call, it's the call which is the statement.
+	q = equals + 3;
+	SkipWhitespace(&q, e);
+	Location call_location;
+	if(q < e && *q == '[' && !ScanLocation(&q, e, &call_location))
+	{
+		return false;
+	}
+	SkipWhitespace(&q, e);
+	if(ParseCall(call_location, q, e, &call))
+	{
+		call->SetLocation(location);
+		statement_list->push_back(call);
+		return true;
+	}
+
+	// Otherwise it's an assignment of some other sort of expression, which is all the same to us
+	// as long as the grammar would have accepted it.  Find the ';' which ends it, skipping over
+	// any string literals.
+	const char *semicolon = NULL;
+	for(q = equals + 3; q < e; ++q)
+	{
+		if(*q == '"')
+		{
+			const char *string_end = q;
+			++string_end;
+			while(string_end < e && *string_end != '"')
+			{
+				string_end += (*string_end == '\\') ? 2 : 1;
+			}
+			if(string_end >= e)
+			{
+				return false;
+			}
+			q = string_end;
+		}
+		else if(*q == ';')
+		{
+			semicolon = q;
+			break;
+		}
+	}
+	if(semicolon == NULL || !IsPlaceholderRhs(equals + 3, semicolon) || !ScanEndOfStatement(semicolon, e))
+	{
+		return false;
+	}
+	statement_list->push_back(m_arena->NewStatement<Placeholder>(location));
+	return true;
+}
+
+bool GimpleFastParser::ParseIf(const Location &location, const char *p, const char *e, StatementList *statement_list)
+{
+	// gcc 4.5.3 style, all on one line:
+	// if (<condition>) goto <label>; else goto <label>;
+	ScanKeyword(&p, e, "if");
+	SkipWhitespace(&p, e);
+	const char *condition_begin = p;
+	if(p == e || *p != '(' || !ScanBalanced(&p, e, '(', ')'))
+	{
+		return false;
+	}
+	std::string condition = TrimmedString(condition_begin + 1, p - 1);
+
+	GotoUnlinked *goto_true;
+	GotoUnlinked *goto_false;
+	Location goto_location;
+
+	SkipWhitespace(&p, e);
+	if(p < e && *p == '[' && !ScanLocation(&p, e, &goto_location))
+	{
+		return false;
+	}
+	SkipWhitespace(&p, e);
+	if(!ParseGoto(goto_location, &p, e, &goto_true))
+	{
+		return false;
+	}
+	SkipWhitespace(&p, e);
+	if(!ScanChar(&p, e, ';'))
+	{
+		return false;
+	}
+	SkipWhitespace(&p, e);
+	if(!ScanKeyword(&p, e, "else"))
+	{
+		return false;
+	}
+
+	goto_location = Location();
+	SkipWhitespace(&p, e);
+	if(p < e && *p == '[' && !ScanLocation(&p, e, &goto_location))
+	{
+		return false;
+	}
+	SkipWhitespace(&p, e);
+	if(!ParseGoto(goto_location, &p, e, &goto_false))
+	{
+		return false;
+	}
+	SkipWhitespace(&p, e);
+	if(!ScanChar(&p, e, ';') || !IsBlank(p, e))
+	{
+		return false;
+	}
+
+	statement_list->push_back(m_arena->NewStatement<IfUnlinked>(location, condition, goto_true, goto_false));
+	return true;
+}
+
+bool GimpleFastParser::ParseGoto(const Location &location, const char **p, const char *e, GotoUnlinked **goto_statement)
+{
+	const char *q = *p;
+	std::string target;
+	if(!ScanKeyword(&q, e, "goto"))
+	{
+		return false;
+	}
+	SkipWhitespace(&q, e);
+	if(!ScanSyntheticLabel(&q, e, &target) && !ScanIdentifier(&q, e, false, &target))
+	{
+		return false;
+	}
+
+	*goto_statement = m_arena->NewStatement<GotoUnlinked>(location, target);
+	*p = q;
+	return true;
+}
+
+bool GimpleFastParser::ParseCall(const Location &location, const char *p, const char *e, StatementBase **call)
+{
+	// <identifier> (<arguments>)
+	std::string identifier;
+	if(!ScanIdentifier(&p, e, true, &identifier))
+	{
+		return false;
+	}
+	SkipWhitespace(&p, e);
+	const char *arguments_begin = p;
+	if(p == e || *p != '(' || !ScanBalanced(&p, e, '(', ')') || !ScanEndOfStatement(p, e))
+	{
+		return false;
+	}
+
+	*call = m_arena->NewStatement<FunctionCallUnresolved>(identifier, location, TrimmedString(arguments_begin + 1, p - 1));
+	return true;
+}
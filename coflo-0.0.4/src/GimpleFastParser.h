@@ -0,0 +1,118 @@
+/*
+ * Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+ *
+ * This file is part of CoFlo.
+ *
+ * CoFlo is free software: you can redistribute it and/or modify it under the
+ * terms of version 3 of the GNU General Public License as published by the Free
+ * Software Foundation.
+ *
+ * CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file */
+
+#ifndef GIMPLEFASTPARSER_H
+#define GIMPLEFASTPARSER_H
+
+#include <string>
+#include <vector>
+
+#include "gcc_gimple_parser.h"
+
+class Location;
+class ParseArena;
+class GotoUnlinked;
+
+/**
+ * A hand-written parser for the common, very regular subset of the dumps gcc produces with
+ * -fdump-tree-gimple-lineno: location prefixes, declarations, nested scopes, assignments,
+ * calls, labels, gotos, if/else goto pairs and returns.
+ *
+ * It works one top-level function definition at a time, and is meant to produce the same
+ * FunctionInfos and statements the dparser grammar in gcc_gimple_parser.g would; the "Fast
+ * parser" group in tests/parallel.at compares the two.  Anything it doesn't recognize, such as
+ * switch statements, C++ function definitions, or an assignment whose right-hand side isn't one
+ * of the forms in the grammar's assignment_statement_internals rule, makes it give up on the
+ * whole function, so the caller can hand that function to the dparser grammar instead.
+ *
+ * It is still more lenient than the grammar in a few places: declarations and the arguments of
+ * calls are skipped without being checked, and location prefixes inside expressions aren't
+ * checked against where the grammar allows them.  Text which is only accepted because of that
+ * is parsed as if it were valid, where dparser would report a syntax error.
+ *
+ * Not thread-safe, but separate instances can be used concurrently.
+ */
+class GimpleFastParser
+{
+public:
+	/**
+	 * Constructor.
+	 *
+	 * @param arena The arena to allocate the FunctionInfos and their contents from.
+	 */
+	GimpleFastParser(ParseArena *arena);
+	~GimpleFastParser();
+
+	/**
+	 * Parse one top-level function definition.
+	 *
+	 * @param begin The start of the function definition.
+	 * @param end The end of the function definition, just past the line holding its closing '}'.
+	 * @return The FunctionInfo for the function, or NULL if the function uses something this
+	 *         parser doesn't handle.  Nothing is leaked in that case, but anything allocated
+	 *         from the arena stays there until the arena is destroyed.
+	 */
+	FunctionInfo* ParseFunction(const char *begin, const char *end);
+
+private:
+
+	/// @name Line-at-a-time access to the text.
+	//@{
+
+	/**
+	 * Get the next line, minus its line ending.
+	 *
+	 * @param[out] line_begin The start of the line.
+	 * @param[out] line_end The end of the line.
+	 * @return false if there are no more lines.
+	 */
+	bool NextLine(const char **line_begin, const char **line_end);
+
+	/// Put back the line most recently returned by NextLine().
+	void PutBackLine() { m_pos = m_previous_line; };
+	//@}
+
+	/// @name Parsers for the various constructs.
+	/// Each returns false if it didn't recognize what it found.
+	//@{
+	bool ParseFunctionDefinition(FunctionInfo **function_info);
+	bool ParseScopeBody(StatementList *statement_list, bool is_function_body);
+	bool ParseDeclarations(bool *found_any);
+	bool ParseStatementList(StatementList *statement_list, bool is_function_body);
+	bool ParseStatement(const char *p, const char *e, StatementList *statement_list);
+	bool ParseIf(const Location &location, const char *p, const char *e, StatementList *statement_list);
+	bool ParseGoto(const Location &location, const char **p, const char *e, GotoUnlinked **goto_statement);
+	/// Parses a whole "identifier (arguments);" line, from @a p to @a e.
+	bool ParseCall(const Location &location, const char *p, const char *e, StatementBase **call);
+	//@}
+
+	/// The arena to allocate the results from.
+	ParseArena *m_arena;
+
+	/// The start of the next line.
+	const char *m_pos;
+
+	/// The start of the line before m_pos.
+	const char *m_previous_line;
+
+	/// The end of the text.
+	const char *m_end;
+};
+
+#endif /* GIMPLEFASTPARSER_H */
@@ -18,19 +18,29 @@
 #include "Location.h"
 
 #include <sstream>
+#include <set>
 
 // Include the necessary Boost libraries.
 #include <boost/regex.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
 
 /// Regex string for matching and capturing locations.
 /// Capture 1 is the path, 2 is the line number, and 3 is the possibly-missing column number.
 static const boost::regex f_location_expression("\\[([^\\]]*?)[[:space:]]\\:[[:space:]]([[:digit:]]+)(?:[[:space:]]?\\:[[:space:]]?([[:digit:]]+))?\\]");
 
+/// The interned file paths.  A std::set never moves its elements, so pointers to them stay valid.
+static std::set< std::string > f_interned_file_paths;
+
+/// Protects f_interned_file_paths, since Locations are created by the parser threads.
+static boost::mutex f_interned_file_paths_mutex;
 
 Location::Location()
 {
-	m_passed_file_path = "UNKNOWN";
-	m_absolute_file_path = m_passed_file_path;
+	// Every Placeholder and NoOp gets one of these, so only look it up once.
+	static const std::string *unknown_file_path = InternFilePath("UNKNOWN");
+
+	m_file_path = unknown_file_path;
 	m_line_number = 0;
 	m_column = -1;
 }
@@ -40,9 +50,8 @@ Location::Location(const std::string &location_string)
 	boost::cmatch capture_results;
 	if(boost::regex_match(location_string.c_str(), capture_results, f_location_expression))
 	{
-		m_passed_file_path = capture_results[1].str();
 		/// @todo Make this really determine the abs path.
-		m_absolute_file_path = m_passed_file_path;
+		m_file_path = InternFilePath(capture_results[1].str());
 		m_line_number = atoi(capture_results[2].str().c_str());
 		if(capture_results[3].matched)
 		{
@@ -56,50 +65,24 @@ Location::Location(const std::string &location_string)
 	else
 	{
 		std::cerr << "WARNING: UNPARSABLE LOCATION: " << location_string << std::endl;
+		m_file_path = InternFilePath("UNKNOWN");
+		m_line_number = 0;
+		m_column = -1;
 	}
 }
 
 Location::Location(const std::string & file_name, long  line, long  column)
 {
-	m_passed_file_path = file_name;
-	m_absolute_file_path = m_passed_file_path;
+	m_file_path = InternFilePath(file_name);
 	m_line_number = line;
 	m_column = column;
 }
 
-Location::Location(const Location& orig)
-{
-	DeepCopy(orig);
-}
-
-Location::~Location()
+const std::string* Location::InternFilePath(const std::string &file_path)
 {
-}
-
-const Location Location::operator=(const Location &other)
-{
-	// Check for self-assignment.
-	if(this == &other)
-	{
-		// This was an attempt to assign to ourself.  Just return this instance.
-		return *this;
-	}
-
-	// Otherwise do the copy.
-	DeepCopy(other);
+	boost::lock_guard<boost::mutex> lock(f_interned_file_paths_mutex);
 
-	return *this;
-}
-
-
-std::string Location::GetPassedFilePath() const
-{
-	return m_passed_file_path;
-}
-
-std::string Location::GetAbsoluteFilePath() const
-{
-	return m_absolute_file_path;
+	return &*(f_interned_file_paths.insert(file_path).first);
 }
 
 /**
@@ -115,20 +98,11 @@ std::ostream& operator<<(std::ostream& os, const Location& loc)
     return os;
 }
 
-void Location::DeepCopy(const Location &orig)
-{
-	// Do a deep (vs. the default shallow) copy of the object.
-	m_passed_file_path = orig.m_passed_file_path;
-	m_absolute_file_path = orig.m_absolute_file_path;
-	m_line_number = orig.m_line_number;
-	m_column = orig.m_column;
-}
-
 std::string Location::asGNUCompilerMessageLocation() const
 {
 	std::stringstream retval;
 
-	retval << m_passed_file_path << ":" << m_line_number;
+	retval << *m_file_path << ":" << m_line_number;
 	if(m_column != -1)
 	{
 		retval << ":" << m_column;
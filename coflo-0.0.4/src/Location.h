@@ -28,6 +28,11 @@
 
 /**
  * Class which encapsulates a location of something in a source file.
+ *
+ * There's one of these in every statement, so it's kept small and cheap to copy.  The file path
+ * isn't stored in the Location itself, but in a program-wide table of interned paths which the
+ * Location points into.  The table is never shrunk, so the pointers stay valid for the life of
+ * the program.
  */
 class Location
 {
@@ -42,34 +47,22 @@ public:
 	 * Constructor which takes a string with the following format as a parameter:
 	 * "[filepath : line_no(:column_no)?]".
 	 *
-	 * Used mainly while parsing the output of gcc.
+	 * This runs a regex match, so it's only for text which really does come from outside,
+	 * such as the output of gcc.  Don't format a string just to pass it in here, use the
+	 * constructor below instead.
 	 *
 	 * @param location_string
 	 */
 	explicit Location(const std::string &location_string);
 
-	Location(const std::string &file_name, long line, long column=-1);
-
-
 	/**
-	 * Copy constructor.
+	 * Constructor which takes the components of the location directly.
 	 *
-	 * @param orig The Location object to copy.
+	 * @param file_name The path of the source file.
+	 * @param line The line number, or 0 if it isn't known.
+	 * @param column The column number, or -1 if it isn't known.
 	 */
-	Location(const Location& orig);
-	virtual ~Location();
-	
-	/// @name Overloaded operators.
-	//@{
-
-	/**
-	 * Assignment from another Location object.
-	 * 
-     * @param other
-     * @return
-     */
-	const Location operator=(const Location &other);
-	//@}
+	Location(const std::string &file_name, long line, long column=-1);
 
 	/// @name Accessors for various components of the Location.
 	//@{
@@ -79,9 +72,10 @@ public:
 	 *
 	 * @return The original path passed to the constructor.
 	 */
-	std::string GetPassedFilePath() const;
+	const std::string& GetPassedFilePath() const { return *m_file_path; };
 	
-	std::string GetAbsoluteFilePath() const;
+	/// @todo This doesn't really determine the absolute path yet, it's the same as GetPassedFilePath().
+	const std::string& GetAbsoluteFilePath() const { return *m_file_path; };
 	
 	long GetLineNumber() const { return m_line_number; };
 	//@}
@@ -106,26 +100,24 @@ public:
 	friend std::ostream& operator<<(std::ostream& os, const Location& loc);
 	
 private:
-	
+
 	/**
-	 * Do a deep (vs. the default shallow) copy of the object.
-	 * Does the work for copy constructors and assignment operators.
+	 * Look up @a file_path in the table of interned paths, adding it if it isn't there yet.
+	 * Thread-safe.
 	 *
-     * @param other The other Location to copy into this one.
-     */
-	void DeepCopy(const Location &orig);
+	 * @param file_path The path to intern.
+	 * @return Pointer to the table's copy of @a file_path.
+	 */
+	static const std::string* InternFilePath(const std::string &file_path);
 
-	/// The file path we were given on construction.
-	std::string m_passed_file_path;
-	
-	/// The absolute file path.
-	std::string m_absolute_file_path;
+	/// The file path we were given on construction, interned.
+	const std::string *m_file_path;
 	
 	/// The line number of the location.
-	long m_line_number;
+	int m_line_number;
 	
-	/// The column of the location.
-	long m_column;
+	/// The column of the location, or -1 if we don't know it.
+	int m_column;
 };
 
 #endif	/* LOCATION_H */
@@ -0,0 +1,323 @@
+/*
+ * Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+ *
+ * This file is part of CoFlo.
+ *
+ * CoFlo is free software: you can redistribute it and/or modify it under the
+ * terms of version 3 of the GNU General Public License as published by the Free
+ * Software Foundation.
+ *
+ * CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file */
+
+#ifndef OBJECTARENA_HPP
+#define OBJECTARENA_HPP
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+/**
+ * An arena of objects of any type, for class hierarchies where TypedArena can't be used.
+ *
+ * Objects are constructed one after another in large blocks, so objects created together end
+ * up together in memory.  As with TypedArena, they can't be freed individually; they're all
+ * destroyed, in the reverse order of their construction, when the arena is cleared or destroyed,
+ * or all at once when the arena is rolled back to a Mark taken before they were created.
+ * Objects never move once constructed, and an arena can take over everything another arena
+ * owns without copying any of it.
+ *
+ * Not thread-safe.  Each thread should have its own arena.
+ */
+class ObjectArena : boost::noncopyable
+{
+public:
+	/// A point in the arena's history which it can be rolled back to.  Opaque to everyone but the arena.
+	struct Mark
+	{
+		void *m_newest;
+		std::size_t m_num_objects;
+		std::size_t m_num_blocks;
+		char *m_last_block;
+		char *m_next_free;
+		char *m_block_end;
+	};
+
+	/**
+	 * Constructor.
+	 *
+	 * @param bytes_per_block The size of the blocks to allocate from the heap.  Objects which
+	 *        don't fit in one get a block of their own.
+	 */
+	explicit ObjectArena(std::size_t bytes_per_block = 16384) : m_bytes_per_block(bytes_per_block),
+			m_next_free(NULL), m_block_end(NULL), m_newest(NULL), m_oldest(NULL), m_num_objects(0) {};
+	~ObjectArena() { Clear(); };
+
+	/// @name Object creation.
+	/// Construct a T in the arena, passing the given arguments on to its constructor.
+	//@{
+	template < typename T >
+	T* New()
+	{
+		Header *header = NextSlot(sizeof(T));
+		T *object = new(ObjectOf(header)) T();
+		Commit(header, &Destroy<T>);
+		return object;
+	};
+
+	template < typename T, typename A1 >
+	T* New(const A1 &a1)
+	{
+		Header *header = NextSlot(sizeof(T));
+		T *object = new(ObjectOf(header)) T(a1);
+		Commit(header, &Destroy<T>);
+		return object;
+	};
+
+	template < typename T, typename A1, typename A2 >
+	T* New(const A1 &a1, const A2 &a2)
+	{
+		Header *header = NextSlot(sizeof(T));
+		T *object = new(ObjectOf(header)) T(a1, a2);
+		Commit(header, &Destroy<T>);
+		return object;
+	};
+
+	template < typename T, typename A1, typename A2, typename A3 >
+	T* New(const A1 &a1, const A2 &a2, const A3 &a3)
+	{
+		Header *header = NextSlot(sizeof(T));
+		T *object = new(ObjectOf(header)) T(a1, a2, a3);
+		Commit(header, &Destroy<T>);
+		return object;
+	};
+
+	template < typename T, typename A1, typename A2, typename A3, typename A4 >
+	T* New(const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4)
+	{
+		Header *header = NextSlot(sizeof(T));
+		T *object = new(ObjectOf(header)) T(a1, a2, a3, a4);
+		Commit(header, &Destroy<T>);
+		return object;
+	};
+	//@}
+
+	/**
+	 * Take over all the objects in @a other, leaving it empty.  They're destroyed along with
+	 * the objects in this arena, before any of them.  Nothing is copied or moved, so the
+	 * adopted objects stay where they are, next to each other.
+	 *
+	 * @param other The arena to empty into this one.
+	 */
+	void Adopt(ObjectArena *other)
+	{
+		if(other == this || other->m_newest == NULL)
+		{
+			return;
+		}
+
+		// Keep filling our own last block, it's the one with room in it.
+		m_blocks.insert(m_blocks.empty() ? m_blocks.end() : m_blocks.end() - 1,
+				other->m_blocks.begin(), other->m_blocks.end());
+
+		other->m_oldest->m_older = m_newest;
+		m_newest = other->m_newest;
+		if(m_oldest == NULL)
+		{
+			m_oldest = other->m_oldest;
+		}
+		m_num_objects += other->m_num_objects;
+
+		other->m_blocks.clear();
+		other->Reset();
+	};
+
+	/// @return A Mark of the arena as it is now.
+	Mark GetMark() const
+	{
+		Mark mark;
+		mark.m_newest = m_newest;
+		mark.m_num_objects = m_num_objects;
+		mark.m_num_blocks = m_blocks.size();
+		mark.m_last_block = m_blocks.empty() ? NULL : m_blocks.back();
+		mark.m_next_free = m_next_free;
+		mark.m_block_end = m_block_end;
+		return mark;
+	};
+
+	/**
+	 * Destroy all the objects constructed since @a mark was taken, in the reverse order of their
+	 * construction, and release the blocks allocated for them.  The arena mustn't have been
+	 * cleared, or have adopted another arena, since then.
+	 *
+	 * @param mark The Mark to roll back to.
+	 */
+	void RollBack(const Mark &mark)
+	{
+		while(m_newest != mark.m_newest)
+		{
+			Header *header = m_newest;
+			m_newest = header->m_older;
+			header->m_destroy(ObjectOf(header));
+		}
+		if(m_newest == NULL)
+		{
+			m_oldest = NULL;
+		}
+		m_num_objects = mark.m_num_objects;
+
+		// Blocks only ever go in at or after the position of the block which was last when the
+		// mark was taken, so everything before that position is untouched.
+		std::vector< char* >::iterator first_new = m_blocks.begin() + ((mark.m_num_blocks == 0) ? 0 : mark.m_num_blocks - 1);
+		for(std::vector< char* >::iterator it = first_new; it != m_blocks.end(); ++it)
+		{
+			if(*it != mark.m_last_block)
+			{
+				::operator delete(*it);
+			}
+		}
+		m_blocks.erase(first_new, m_blocks.end());
+		if(mark.m_last_block != NULL)
+		{
+			m_blocks.push_back(mark.m_last_block);
+		}
+		m_next_free = mark.m_next_free;
+		m_block_end = mark.m_block_end;
+	};
+
+	/**
+	 * Destroy all the objects in the arena, in the reverse order of their construction, and
+	 * release the memory they occupied.
+	 */
+	void Clear()
+	{
+		for(Header *header = m_newest; header != NULL; header = header->m_older)
+		{
+			header->m_destroy(ObjectOf(header));
+		}
+		for(std::vector< char* >::iterator it = m_blocks.begin(); it != m_blocks.end(); ++it)
+		{
+			::operator delete(*it);
+		}
+		m_blocks.clear();
+		Reset();
+	};
+
+	/// @name Statistics.
+	//@{
+	std::size_t GetNumberOfObjects() const { return m_num_objects; };
+	std::size_t GetNumberOfBlocks() const { return m_blocks.size(); };
+	//@}
+
+private:
+
+	/// The bookkeeping which precedes each object in its block.
+	struct Header
+	{
+		/// Destroys the object following this header.
+		void (*m_destroy)(void *object);
+
+		/// The header of the object constructed just before this one, or NULL if this is the oldest.
+		Header *m_older;
+	};
+
+	/// The strictest alignment any of the objects could need.
+	union MaxAlign
+	{
+		long double m_long_double;
+		long m_long;
+		void *m_pointer;
+		void (*m_function_pointer)();
+	};
+
+	/// The space taken up by a Header, rounded up so that the object after it is aligned.
+	static std::size_t HeaderSize()
+	{
+		const std::size_t alignment = boost::alignment_of<MaxAlign>::value;
+		return (sizeof(Header) + alignment - 1) / alignment * alignment;
+	};
+
+	static void* ObjectOf(Header *header) { return reinterpret_cast<char*>(header) + HeaderSize(); };
+
+	template < typename T >
+	static void Destroy(void *object) { static_cast<T*>(object)->~T(); };
+
+	/// Return space for a header and an object of @a object_size bytes, starting a new block if necessary.
+	Header* NextSlot(std::size_t object_size)
+	{
+		const std::size_t alignment = boost::alignment_of<MaxAlign>::value;
+		std::size_t slot_size = HeaderSize() + (object_size + alignment - 1) / alignment * alignment;
+
+		if(slot_size > m_bytes_per_block)
+		{
+			// Too big to share a block.  Give it one of its own, ahead of the one we're filling.
+			char *block = static_cast<char*>(::operator new(slot_size));
+			m_blocks.insert(m_blocks.empty() ? m_blocks.end() : m_blocks.end() - 1, block);
+			return reinterpret_cast<Header*>(block);
+		}
+
+		if(m_next_free == NULL || static_cast<std::size_t>(m_block_end - m_next_free) < slot_size)
+		{
+			m_blocks.reserve(m_blocks.size() + 1);
+			m_next_free = static_cast<char*>(::operator new(m_bytes_per_block));
+			m_block_end = m_next_free + m_bytes_per_block;
+			m_blocks.push_back(m_next_free);
+		}
+
+		Header *header = reinterpret_cast<Header*>(m_next_free);
+		m_next_free += slot_size;
+		return header;
+	};
+
+	/// Account for a successful construction after the header returned by NextSlot().
+	void Commit(Header *header, void (*destroy)(void *object))
+	{
+		header->m_destroy = destroy;
+		header->m_older = m_newest;
+		m_newest = header;
+		if(m_oldest == NULL)
+		{
+			m_oldest = header;
+		}
+		++m_num_objects;
+	};
+
+	/// Forget about all the blocks and objects, without freeing anything.
+	void Reset()
+	{
+		m_next_free = NULL;
+		m_block_end = NULL;
+		m_newest = NULL;
+		m_oldest = NULL;
+		m_num_objects = 0;
+	};
+
+	/// The size of the blocks we allocate from the heap.
+	std::size_t m_bytes_per_block;
+
+	/// All the blocks.  The last one is the one we're currently filling.
+	std::vector< char* > m_blocks;
+
+	/// The free space at the end of the last block.
+	char *m_next_free;
+	char *m_block_end;
+
+	/// The most and least recently constructed objects' headers.
+	Header *m_newest;
+	Header *m_oldest;
+
+	/// The number of objects constructed.
+	std::size_t m_num_objects;
+};
+
+#endif /* OBJECTARENA_HPP */
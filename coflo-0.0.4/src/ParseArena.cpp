@@ -0,0 +1,48 @@
+/*
+ * Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+ *
+ * This file is part of CoFlo.
+ *
+ * CoFlo is free software: you can redistribute it and/or modify it under the
+ * terms of version 3 of the GNU General Public License as published by the Free
+ * Software Foundation.
+ *
+ * CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file */
+
+#include "ParseArena.h"
+
+ParseArena::ParseArena()
+{
+}
+
+ParseArena::~ParseArena()
+{
+}
+
+std::size_t ParseArena::GetNumberOfObjects() const
+{
+	return m_strings.GetNumberOfObjects()
+			+ m_locations.GetNumberOfObjects()
+			+ m_statement_lists.GetNumberOfObjects()
+			+ m_function_infos.GetNumberOfObjects()
+			+ m_function_info_lists.GetNumberOfObjects()
+			+ m_statements.GetNumberOfObjects();
+}
+
+std::size_t ParseArena::GetNumberOfBlocks() const
+{
+	return m_strings.GetNumberOfBlocks()
+			+ m_locations.GetNumberOfBlocks()
+			+ m_statement_lists.GetNumberOfBlocks()
+			+ m_function_infos.GetNumberOfBlocks()
+			+ m_function_info_lists.GetNumberOfBlocks()
+			+ m_statements.GetNumberOfBlocks();
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+ *
+ * This file is part of CoFlo.
+ *
+ * CoFlo is free software: you can redistribute it and/or modify it under the
+ * terms of version 3 of the GNU General Public License as published by the Free
+ * Software Foundation.
+ *
+ * CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file */
+
+#ifndef PARSEARENA_H
+#define PARSEARENA_H
+
+#include <cstddef>
+#include <string>
+
+#include <boost/noncopyable.hpp>
+
+#include "TypedArena.hpp"
+#include "ObjectArena.hpp"
+#include "Location.h"
+#include "gcc_gimple_parser.h"
+
+/**
+ * Owner of the objects the GIMPLE grammar actions create while parsing: strings, Locations,
+ * the lists they pass up the parse tree, and the statements.  Everything but the statements
+ * is released in one step when the arena is destroyed, once the Functions have been built
+ * from the parse results.
+ *
+ * The statements end up in the ControlFlowGraph, so before that happens the graph takes them
+ * over with ControlFlowGraph::AdoptStatements().  They stay where they were allocated, in
+ * parse order, so each function's statements are next to each other in memory.
+ *
+ * Not thread-safe.  Each parser has its own arena.
+ */
+class ParseArena : boost::noncopyable
+{
+public:
+	ParseArena();
+	~ParseArena();
+
+	/// @name Object creation.
+	//@{
+	std::string* NewString(const std::string &str) { return m_strings.Construct(str); };
+	Location* NewLocation(const Location &location) { return m_locations.Construct(location); };
+	StatementList* NewStatementList() { return m_statement_lists.Construct(); };
+	FunctionInfo* NewFunctionInfo() { return m_function_infos.Construct(); };
+	FunctionInfoList* NewFunctionInfoList() { return m_function_info_lists.Construct(); };
+
+	template < typename T, typename A1 >
+	T* NewStatement(const A1 &a1) { return m_statements.New<T>(a1); };
+	template < typename T, typename A1, typename A2 >
+	T* NewStatement(const A1 &a1, const A2 &a2) { return m_statements.New<T>(a1, a2); };
+	template < typename T, typename A1, typename A2, typename A3 >
+	T* NewStatement(const A1 &a1, const A2 &a2, const A3 &a3) { return m_statements.New<T>(a1, a2, a3); };
+	template < typename T, typename A1, typename A2, typename A3, typename A4 >
+	T* NewStatement(const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4) { return m_statements.New<T>(a1, a2, a3, a4); };
+	//@}
+
+	/// Returns the arena the statements are allocated from, so they can be handed over to the ControlFlowGraph.
+	ObjectArena* GetStatementArena() { return &m_statements; };
+
+	/// @name Statistics.
+	//@{
+	/// Returns the number of objects created, each of which would otherwise have been a separate heap allocation.
+	std::size_t GetNumberOfObjects() const;
+	/// Returns the number of blocks the arena has allocated from the heap to hold the objects.
+	std::size_t GetNumberOfBlocks() const;
+	//@}
+
+private:
+
+	TypedArena< std::string > m_strings;
+	TypedArena< Location > m_locations;
+	TypedArena< StatementList > m_statement_lists;
+	TypedArena< FunctionInfo > m_function_infos;
+	TypedArena< FunctionInfoList > m_function_info_lists;
+	ObjectArena m_statements;
+};
+
+#endif /* PARSEARENA_H */
@@ -18,6 +18,7 @@
 
 #include <fstream>
 #include <iostream>
+#include <utility>
 #include <sys/types.h>
 #include <sys/stat.h>
 
@@ -25,13 +26,83 @@
 
 #include "Program.h"
 #include "TranslationUnit.h"
+#include "parallel_for.hpp"
 //#include "RuleReachability.h"
 #include "controlflowgraph/statements/FunctionCall.h"
 #include "Function.h"
 
-Program::Program()
+/**
+ * parallel_for() body which runs the thread-safe half of the parse for one TranslationUnit.
+ */
+class CompileAndParseTranslationUnit
 {
+public:
+	CompileAndParseTranslationUnit(const std::vector< TranslationUnit* > &translation_units,
+			std::vector< char > *results,
+			const std::string &the_filter,
+			ToolCompiler *compiler,
+			const std::vector< std::string > &defines,
+			const std::vector< std::string > &include_paths,
+			bool debug_parse,
+			bool compile_only = false) : m_translation_units(translation_units), m_results(results),
+			m_the_filter(the_filter), m_compiler(compiler), m_defines(defines), m_include_paths(include_paths),
+			m_debug_parse(debug_parse), m_compile_only(compile_only) {};
+
+	void operator()(long i)
+	{
+		if(m_compile_only)
+		{
+			(*m_results)[i] = m_translation_units[i]->Compile(m_the_filter, m_compiler,
+					m_defines, m_include_paths);
+		}
+		else
+		{
+			(*m_results)[i] = m_translation_units[i]->CompileAndParse(m_the_filter, m_compiler,
+					m_defines, m_include_paths, m_debug_parse);
+		}
+	};
+
+private:
+	const std::vector< TranslationUnit* > &m_translation_units;
+	/// One result per TranslationUnit.  Not a vector<bool>, so that each thread writes to its own element.
+	std::vector< char > *m_results;
+	const std::string &m_the_filter;
+	ToolCompiler *m_compiler;
+	const std::vector< std::string > &m_defines;
+	const std::vector< std::string > &m_include_paths;
+	bool m_debug_parse;
+	/// If true, only do the Compile() step, leaving the parsing to ParseTranslationUnitDumpChunk.
+	bool m_compile_only;
+};
 
+/// A GIMPLE dump chunk, identified by its TranslationUnit and its index within that TranslationUnit.
+typedef std::pair< TranslationUnit*, long > T_DUMP_CHUNK_ID;
+
+/**
+ * parallel_for() body which parses one chunk of one TranslationUnit's GIMPLE dump.
+ */
+class ParseTranslationUnitDumpChunk
+{
+public:
+	ParseTranslationUnitDumpChunk(const std::vector< T_DUMP_CHUNK_ID > &chunk_ids) : m_chunk_ids(chunk_ids) {};
+
+	void operator()(long i)
+	{
+		m_chunk_ids[i].first->ParseDumpChunk(m_chunk_ids[i].second);
+	};
+
+private:
+	const std::vector< T_DUMP_CHUNK_ID > &m_chunk_ids;
+};
+
+Program::Program()
+{
+	m_num_jobs = 1;
+	m_gimple_dump_cache = NULL;
+	m_temps_dir = boost::filesystem::temp_directory_path();
+	m_stream_gimple_dump = false;
+	m_parse_by_function = false;
+	m_parse_with_dparser = false;
 }
 
 Program::Program(const Program& orig)
@@ -40,6 +111,10 @@ Program::Program(const Program& orig)
 
 Program::~Program()
 {
+	BOOST_FOREACH(TranslationUnit *tu, m_translation_units)
+	{
+		delete tu;
+	}
 }
 
 void Program::SetTheDot(ToolDot *the_dot)
@@ -57,6 +132,36 @@ void Program::SetTheFilter(const std::string &the_filter)
 	m_the_filter = the_filter;
 }
 
+void Program::SetNumberOfJobs(long num_jobs)
+{
+	m_num_jobs = num_jobs;
+}
+
+void Program::SetGimpleDumpCache(GimpleDumpCache *dump_cache)
+{
+	m_gimple_dump_cache = dump_cache;
+}
+
+void Program::SetTempsDir(const boost::filesystem::path &temps_dir)
+{
+	m_temps_dir = temps_dir;
+}
+
+void Program::SetStreamGimpleDump(bool stream_gimple_dump)
+{
+	m_stream_gimple_dump = stream_gimple_dump;
+}
+
+void Program::SetParseByFunction(bool parse_by_function)
+{
+	m_parse_by_function = parse_by_function;
+}
+
+void Program::SetParseWithDParser(bool parse_with_dparser)
+{
+	m_parse_with_dparser = parse_with_dparser;
+}
+
 void Program::AddSourceFiles(const std::vector< std::string > &file_paths)
 {
 	BOOST_FOREACH(std::string input_file_path, file_paths)
@@ -70,17 +175,78 @@ bool Program::Parse(const std::vector< std::string > &defines,
 		T_ID_TO_FUNCTION_CALL_UNRESOLVED_MAP *unresolved_function_calls,
 		bool debug_parse)
 {
-	BOOST_FOREACH(TranslationUnit *tu, m_translation_units)
+	if(m_num_jobs <= 1)
 	{
-		// Parse this file.
-		std::cout << "Parsing \"" << tu->GetFilePath() << "\"..." << std::endl;
-		bool retval = tu->ParseFile(tu->GetFilePath(), &m_function_map,
-								 m_the_filter, m_compiler,
-								 defines, include_paths, debug_parse);
-		if(retval == false)
+		BOOST_FOREACH(TranslationUnit *tu, m_translation_units)
 		{
-			std::cerr << "ERROR: Couldn't parse \"" << tu->GetFilePath() << "\"" << std::endl;
-			return false;
+			// Parse this file.
+			std::cout << "Parsing \"" << tu->GetFilePath() << "\"..." << std::endl;
+			bool retval = tu->ParseFile(tu->GetFilePath(), &m_function_map,
+									 m_the_filter, m_compiler,
+									 defines, include_paths, debug_parse);
+			if(retval == false)
+			{
+				std::cerr << "ERROR: Couldn't parse \"" << tu->GetFilePath() << "\"" << std::endl;
+				return false;
+			}
+		}
+	}
+	else
+	{
+		std::vector< char > results(m_translation_units.size(), false);
+
+		if(!m_parse_by_function)
+		{
+			// Compile and parse all the files in parallel.
+			parallel_for(m_num_jobs, m_translation_units.size(),
+					CompileAndParseTranslationUnit(m_translation_units, &results,
+							m_the_filter, m_compiler, defines, include_paths, debug_parse));
+		}
+		else
+		{
+			// Compile all the files in parallel.
+			parallel_for(m_num_jobs, m_translation_units.size(),
+					CompileAndParseTranslationUnit(m_translation_units, &results,
+							m_the_filter, m_compiler, defines, include_paths, debug_parse, true));
+
+			// Then parse all the functions of all the files in parallel.  Working from one
+			// flat list of functions keeps all the jobs busy even when one file has far more
+			// functions than all the others put together.
+			std::vector< T_DUMP_CHUNK_ID > chunk_ids;
+			for(std::vector< TranslationUnit* >::size_type i = 0; i < m_translation_units.size(); ++i)
+			{
+				if(results[i])
+				{
+					for(long chunk_index = 0; chunk_index < m_translation_units[i]->GetNumberOfDumpChunks(); ++chunk_index)
+					{
+						chunk_ids.push_back(T_DUMP_CHUNK_ID(m_translation_units[i], chunk_index));
+					}
+				}
+			}
+			parallel_for(m_num_jobs, chunk_ids.size(), ParseTranslationUnitDumpChunk(chunk_ids));
+
+			for(std::vector< TranslationUnit* >::size_type i = 0; i < m_translation_units.size(); ++i)
+			{
+				if(results[i])
+				{
+					m_translation_units[i]->FinishParse();
+				}
+			}
+		}
+
+		// Now build the Functions serially, in the order the files were given to us, so that
+		// the Function map and ControlFlowGraph come out exactly as they would in a serial run.
+		for(std::vector< TranslationUnit* >::size_type i = 0; i < m_translation_units.size(); ++i)
+		{
+			TranslationUnit *tu = m_translation_units[i];
+
+			std::cout << "Parsing \"" << tu->GetFilePath() << "\"..." << std::endl;
+			if(!results[i])
+			{
+				std::cerr << "ERROR: Couldn't parse \"" << tu->GetFilePath() << "\"" << std::endl;
+				return false;
+			}
+			tu->BuildFunctions(&m_function_map);
 		}
 	}
 
@@ -92,10 +258,18 @@ bool Program::Parse(const std::vector< std::string > &defines,
 		tu->Link(m_function_map, unresolved_function_calls);
 	}
 
+	// The graph is complete.  Freeze it so the analyses can run on the compact snapshot.
+	m_cfg.Freeze();
+
 	// Parsing was successful.
 	return true;
 }
 
+Function* Program::NewFunction(TranslationUnit *parent_tu, const std::string &function_id)
+{
+	return m_functions.Construct(parent_tu, function_id);
+}
+
 Function *Program::LookupFunction(const std::string &function_id)
 {
 	T_ID_TO_FUNCTION_PTR_MAP::iterator fit;
@@ -24,12 +24,16 @@
 #include <string>
 #include <map>
 
+#include <boost/filesystem.hpp>
+
+#include "TypedArena.hpp"
 #include "controlflowgraph/ControlFlowGraph.h"
 
 class TranslationUnit;
 class Function;
 class ToolCompiler;
 class ToolDot;
+class GimpleDumpCache;
 
 /// Map of identifiers to pointers to the Function objects the correspond to.
 typedef std::map< std::string, Function* > T_ID_TO_FUNCTION_PTR_MAP;
@@ -40,6 +44,10 @@ typedef std::multimap< std::string, FunctionCallUnresolved*> T_ID_TO_FUNCTION_CA
 /**
  * Encapsulates the concept of an entire program, consisting of one or more
  * translation units.
+ *
+ * The Program owns everything built from its source files: the TranslationUnits, the Functions,
+ * and through the ControlFlowGraph, the statements.  Destroying it releases all of them, so many
+ * Programs can be parsed one after another in the same process.
  */
 class Program
 {
@@ -52,6 +60,60 @@ public:
     void SetTheGcc(ToolCompiler *the_compiler);
     void SetTheFilter(const std::string &the_filter);
 
+	/**
+	 * Set the maximum number of TranslationUnits to compile and parse at once.
+	 *
+	 * @param num_jobs Number of worker threads to use.  1 (the default) parses serially.
+	 */
+	void SetNumberOfJobs(long num_jobs);
+
+	/**
+	 * Set the cache to consult for GIMPLE dumps before running the compiler.
+	 *
+	 * @param dump_cache The cache to use, or NULL (the default) to always run the compiler.
+	 */
+	void SetGimpleDumpCache(GimpleDumpCache *dump_cache);
+	GimpleDumpCache* GetGimpleDumpCache() const { return m_gimple_dump_cache; };
+
+	/**
+	 * Set the directory under which each compile gets its own scratch directory for
+	 * the compiler's intermediate files.
+	 *
+	 * @param temps_dir The directory.  Defaults to the system's temporary directory.
+	 */
+	void SetTempsDir(const boost::filesystem::path &temps_dir);
+	const boost::filesystem::path& GetTempsDir() const { return m_temps_dir; };
+
+	/**
+	 * Set whether the compiler should send its GIMPLE dumps to us through a pipe, rather than
+	 * through files in a scratch directory.
+	 *
+	 * @param stream_gimple_dump true to use a pipe.  The compiler must support it, see
+	 *        ToolCompiler::CanDumpToStdout().
+	 */
+	void SetStreamGimpleDump(bool stream_gimple_dump);
+	bool GetStreamGimpleDump() const { return m_stream_gimple_dump; };
+
+	/**
+	 * Set whether the GIMPLE dumps should be split up and parsed one top-level function
+	 * at a time, rather than all at once.  This keeps the peak memory usage down to what
+	 * the largest function needs, rather than what the largest file needs.
+	 *
+	 * @param parse_by_function true to parse one function at a time.
+	 */
+	void SetParseByFunction(bool parse_by_function);
+	bool GetParseByFunction() const { return m_parse_by_function; };
+
+	/**
+	 * Set whether the GIMPLE dumps should be parsed with the full dparser grammar only.
+	 * Normally each function is first handed to the hand-written GimpleFastParser, and
+	 * only the ones it doesn't recognize go to dparser.
+	 *
+	 * @param parse_with_dparser true to skip the fast parser.
+	 */
+	void SetParseWithDParser(bool parse_with_dparser);
+	bool GetParseWithDParser() const { return m_parse_with_dparser; };
+
 	void AddSourceFiles(const std::vector< std::string > &file_paths);
 	
 	bool Parse(const std::vector< std::string > &defines,
@@ -98,6 +160,15 @@ public:
 	
 	ControlFlowGraph* GetControlFlowGraphPtr() { return &m_cfg; };
 
+	/**
+	 * Create a new Function belonging to this Program.  It lives until the Program is destroyed.
+	 *
+	 * @param parent_tu The TranslationUnit the Function is defined in.
+	 * @param function_id The Function's identifier.
+	 * @return The new Function.
+	 */
+	Function* NewFunction(TranslationUnit *parent_tu, const std::string &function_id);
+
 private:
 
 	/// The TranslationUnits which make up this Program.
@@ -113,8 +184,29 @@ private:
 	/// the graph drawings.
 	ToolDot *m_the_dot;
 	
+	/// Maximum number of TranslationUnits to compile and parse concurrently.
+	long m_num_jobs;
+
+	/// The GIMPLE dump cache, or NULL if we're not using one.
+	GimpleDumpCache *m_gimple_dump_cache;
+
+	/// The directory to put the per-compile scratch directories in.
+	boost::filesystem::path m_temps_dir;
+
+	/// Whether to read the GIMPLE dumps from a pipe instead of from files.
+	bool m_stream_gimple_dump;
+
+	/// Whether to parse the GIMPLE dumps one function at a time.
+	bool m_parse_by_function;
+
+	/// Whether to bypass the fast parser.
+	bool m_parse_with_dparser;
+
 	/// The Control Flow Graph for the Program.
 	ControlFlowGraph m_cfg;
+
+	/// The Functions of all the TranslationUnits.
+	TypedArena< Function > m_functions;
 	
 	/// The identifier string to Function* map.
 	T_ID_TO_FUNCTION_PTR_MAP m_function_map;
@@ -21,6 +21,8 @@
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <cstring>
 #include <sys/types.h>
 #include <sys/stat.h>
 
@@ -36,6 +38,9 @@
 
 #include "Location.h"
 #include "Function.h"
+#include "GimpleDumpCache.h"
+#include "GimpleFastParser.h"
+#include "ParseArena.h"
 
 #include "controlflowgraph/statements/If.h"
 #include "controlflowgraph/statements/FunctionCallUnresolved.h"
@@ -49,11 +54,12 @@
 using namespace boost;
 using namespace boost::filesystem;
 
-
 TranslationUnit::TranslationUnit(Program *parent_program, const std::string &file_path)
 {
 	m_parent_program = parent_program;
 	m_source_filename = file_path;
+	m_function_info_list = NULL;
+	m_syntax_error_count = 0;
 }
 
 TranslationUnit::TranslationUnit(const TranslationUnit& orig)
@@ -63,6 +69,10 @@ TranslationUnit::TranslationUnit(const TranslationUnit& orig)
 
 TranslationUnit::~TranslationUnit()
 {
+	// Release anything left over from a parse that never got as far as building Functions.
+	ReleaseDump();
+	ReleaseParseArenas();
+	delete m_function_info_list;
 }
 
 bool TranslationUnit::ParseFile(const boost::filesystem::path &filename,
@@ -73,87 +83,188 @@ bool TranslationUnit::ParseFile(const boost::filesystem::path &filename,
 								const std::vector< std::string > &include_paths,
 								bool debug_parse)
 {
-	std::string gcc_cfg_lineno_blocks_filename;
-	bool file_is_cpp = false;
-	
 	// Save the source filename.
 	m_source_filename = filename;
-	
+
+	// With parse-by-function, each function's parse tree is freed as soon as it's been parsed,
+	// but nothing gets built until the whole file has parsed, same as when the Program parses
+	// several files at once.  A file with syntax errors anywhere in it builds no Functions.
+	if(!CompileAndParse(the_filter, compiler, defines, include_paths, debug_parse))
+	{
+		return false;
+	}
+
+	BuildFunctions(function_map);
+
+	return true;
+}
+
+bool TranslationUnit::CompileAndParse(const std::string &the_filter,
+								ToolCompiler *compiler,
+								const std::vector< std::string > &defines,
+								const std::vector< std::string > &include_paths,
+								bool debug_parse)
+{
+	if(!Compile(the_filter, compiler, defines, include_paths))
+	{
+		return false;
+	}
+
+	for(long i = 0; i < GetNumberOfDumpChunks(); ++i)
+	{
+		ParseDumpChunk(i);
+	}
+
+	FinishParse();
+
+	return true;
+}
+
+bool TranslationUnit::Compile(const std::string &the_filter,
+								ToolCompiler *compiler,
+								const std::vector< std::string > &defines,
+								const std::vector< std::string > &include_paths)
+{
+	bool file_is_cpp = false;
+
 	// Check if it's a C++ file.
-	if(filename.extension() == ".cpp")
+	if(m_source_filename.extension() == ".cpp")
 	{
 		dlog_parse_gimple << "File is C++" << std::endl;
 		file_is_cpp = true;
 	}
 	
-	// Try to compile the source file into the .gimple intermediate form.
-	CompileSourceFile(filename.generic_string(), the_filter, compiler, defines, include_paths);
-	
-	// Construct the filename of the .cfg file gcc made for us.
-	// gcc puts this file in the directory it's running in.
-	gcc_cfg_lineno_blocks_filename = filename.filename().generic_string();
-	gcc_cfg_lineno_blocks_filename += ".coflo.gimple";
-		
-	// Try to open the file whose name we were passed.
-	std::ifstream input_file(gcc_cfg_lineno_blocks_filename.c_str(), std::ifstream::in);
-
-	// Check if we were able to open the file.
-	if(input_file.fail())
+	// Get the .gimple intermediate form of the source file.
+	if(!CompileSourceFile(m_source_filename.generic_string(), the_filter, compiler, defines, include_paths, &m_dump_buffer))
 	{
-		std::cerr << "ERROR: Couldn't open file \"" << gcc_cfg_lineno_blocks_filename << "\"" << std::endl;
 		return false;
 	}
 
+	//std::cout << "Read >>>>>" << m_dump_buffer.GetData() << "<<<<<" << std::endl;
+
+	m_dump_chunks.clear();
+	if(m_parent_program->GetParseByFunction())
+	{
+		m_dump_buffer.SplitIntoFunctions(&m_dump_chunks);
+	}
+	else
+	{
+		GimpleDumpChunk whole_file = { m_dump_buffer.GetData(), m_dump_buffer.GetLength(), true };
+		m_dump_chunks.push_back(whole_file);
+	}
+
+	m_chunk_function_info_lists.assign(m_dump_chunks.size(), NULL);
+	m_chunk_syntax_error_counts.assign(m_dump_chunks.size(), 0);
+	m_chunk_arenas.assign(m_dump_chunks.size(), NULL);
 
-	// Load the given file into memory.
-	std::string buffer;
-	char previous_char = '\n';
+	return true;
+}
 
-	while (input_file.good())     // loop while extraction from file is possible
+void TranslationUnit::ParseDumpChunk(long chunk_index)
+{
+	const GimpleDumpChunk &chunk = m_dump_chunks[chunk_index];
+
+	// Everything parsed from this chunk gets allocated from an arena of its own.
+	ParseArena *arena = new ParseArena;
+	m_chunk_arenas[chunk_index] = arena;
+
+	long syntax_error_count = 0;
+	FunctionInfoList *function_info_list = NULL;
+	bool parsed = true;
+
+	if(m_parent_program->GetParseWithDParser())
 	{
-		char c;
-		c = input_file.get();       // get character from file
-		if (input_file.good())
+		// Parse the whole chunk the old way.
+		parsed = ParseWithDParser(chunk.m_data, chunk.m_length, chunk.m_nul_terminated, arena,
+				&function_info_list, &syntax_error_count);
+	}
+	else
+	{
+		// Hand each function to the fast parser, falling back to dparser for the ones it
+		// doesn't recognize.
+		GimpleFastParser fast_parser(arena);
+		const char *p = chunk.m_data;
+		const char *end = chunk.m_data + chunk.m_length;
+
+		function_info_list = arena->NewFunctionInfoList();
+		while(true)
 		{
-			if(c == '\r')
+			// Skip the blank lines between functions.
+			while(p < end && strchr(" \t\r\n", *p) != NULL)
+			{
+				++p;
+			}
+			if(p >= end)
+			{
+				break;
+			}
+
+			const char *function_end = GimpleDumpBuffer::FindEndOfFunction(p, end);
+			if(function_end == NULL)
 			{
-				// Strip CR's.
-				continue;
+				// Let dparser complain about it.
+				function_end = end;
+			}
+
+			FunctionInfo *function_info = fast_parser.ParseFunction(p, function_end);
+			if(function_info != NULL)
+			{
+				function_info_list->push_back(function_info);
 			}
 			else
 			{
-				buffer += c;
+				dlog_parse_gimple << "Fast parser gave up on function at offset " << (p - chunk.m_data)
+						<< " of \"" << m_source_filename.generic_string() << "\", falling back to dparser." << std::endl;
+
+				FunctionInfoList *fallback_function_info_list = NULL;
+				if(ParseWithDParser(p, function_end - p, false, arena, &fallback_function_info_list, &syntax_error_count))
+				{
+					function_info_list->insert(function_info_list->end(),
+							fallback_function_info_list->begin(), fallback_function_info_list->end());
+				}
+				else
+				{
+					parsed = false;
+				}
 			}
-			previous_char = c;
+
+			p = function_end;
 		}
 	}
 
-	// Close file
-	input_file.close();
-
-	//std::cout << "Read >>>>>" << buffer << "<<<<<" << std::endl;
+	m_chunk_syntax_error_counts[chunk_index] = syntax_error_count;
+	if(parsed)
+	{
+		// Parsed the chunk successfully.
+		dlog_parse_gimple << "File \"" << m_source_filename.generic_string() << "\" parsed successfully." << std::endl;
 
-	// Create a new parser.
-	D_Parser *parser = new_gcc_gimple_Parser();
-	D_ParseNode *tree = gcc_gimple_dparse(parser, const_cast<char*>(buffer.c_str()), buffer.length());
+		// Hang on to the FunctionInfos.  They're owned by the arena, so they outlive the parser.
+		m_chunk_function_info_lists[chunk_index] = function_info_list;
+	}
+}
 
-	if (tree && !gcc_gimple_parser_GetSyntaxErrorCount(parser))
+bool TranslationUnit::ParseWithDParser(const char *data, std::size_t length, bool nul_terminated, ParseArena *arena,
+		std::vector< FunctionInfo* > **function_info_list, long *syntax_error_count)
+{
+	// Always give the parser NUL-terminated text, copying it out if need be.
+	std::string copy;
+	if(!nul_terminated)
 	{
-		// Parsed the .coflo.gimple file successfully.
+		copy.assign(data, length);
+		data = copy.c_str();
+	}
 
-		dlog_parse_gimple << "File \"" << filename.generic_string() << "\" parsed successfully." << std::endl;
+	D_Parser *parser = new_gcc_gimple_Parser(arena);
+	D_ParseNode *tree = gcc_gimple_dparse(parser, const_cast<char*>(data), length);
 
-		FunctionInfoList *fil = gcc_gimple_parser_GetUserInfo(tree)->m_function_info_list;
+	long errors = gcc_gimple_parser_GetSyntaxErrorCount(parser);
+	*syntax_error_count += errors;
 
-		// Build the Functions out of the info obtained from the parsing.
-		std::cout << "Building Functions..." << std::endl;
-		BuildFunctionsFromThreeAddressFormStatementLists(*fil, function_map);
-	}
-	else
+	bool parsed = false;
+	if (tree && !errors)
 	{
-		// The parse failed.
-
-		std::cout << "Failure: " << gcc_gimple_parser_GetSyntaxErrorCount(parser) << " syntax errors." << std::endl;
+		*function_info_list = gcc_gimple_parser_GetUserInfo(tree)->m_function_info_list;
+		parsed = true;
 	}
 
 	if(tree != NULL)
@@ -164,7 +275,107 @@ bool TranslationUnit::ParseFile(const boost::filesystem::path &filename,
 	// Destroy the parser.
 	free_gcc_gimple_Parser(parser);
 
-	return true;
+	return parsed;
+}
+
+void TranslationUnit::FinishParse()
+{
+	bool all_parsed = true;
+
+	// Stitch the chunks' FunctionInfos back together in source order.
+	m_syntax_error_count = 0;
+	m_function_info_list = new FunctionInfoList;
+	for(std::vector< FunctionInfoList* >::size_type i = 0; i < m_chunk_function_info_lists.size(); ++i)
+	{
+		m_syntax_error_count += m_chunk_syntax_error_counts[i];
+
+		FunctionInfoList *chunk_function_info_list = m_chunk_function_info_lists[i];
+		if(chunk_function_info_list == NULL)
+		{
+			all_parsed = false;
+			continue;
+		}
+
+		m_function_info_list->insert(m_function_info_list->end(),
+				chunk_function_info_list->begin(), chunk_function_info_list->end());
+	}
+
+	// The arenas have to stay around until the Functions have been built.
+	for(std::vector< ParseArena* >::size_type i = 0; i < m_chunk_arenas.size(); ++i)
+	{
+		if(m_chunk_arenas[i] != NULL)
+		{
+			m_parse_arenas.push_back(m_chunk_arenas[i]);
+			m_chunk_arenas[i] = NULL;
+		}
+	}
+
+	if(!all_parsed)
+	{
+		// We won't be building anything, so we're done with the FunctionInfos we did get.
+		delete m_function_info_list;
+		m_function_info_list = NULL;
+		ReleaseParseArenas();
+	}
+
+	ReleaseDump();
+}
+
+void TranslationUnit::ReleaseDump()
+{
+	BOOST_FOREACH(ParseArena *arena, m_chunk_arenas)
+	{
+		delete arena;
+	}
+	m_chunk_arenas.clear();
+	m_chunk_function_info_lists.clear();
+	m_chunk_syntax_error_counts.clear();
+	m_dump_chunks.clear();
+	m_dump_buffer.Clear();
+}
+
+void TranslationUnit::ReleaseParseArenas()
+{
+	BOOST_FOREACH(ParseArena *arena, m_parse_arenas)
+	{
+		LogParseArenaStatistics(*arena);
+		delete arena;
+	}
+	m_parse_arenas.clear();
+}
+
+void TranslationUnit::LogParseArenaStatistics(const ParseArena &arena) const
+{
+	dlog_parse_gimple << "Parse arena for \"" << m_source_filename.generic_string() << "\": "
+			<< arena.GetNumberOfObjects() << " objects in "
+			<< arena.GetNumberOfBlocks() << " heap blocks." << std::endl;
+}
+
+void TranslationUnit::BuildFunctions(T_ID_TO_FUNCTION_PTR_MAP *function_map)
+{
+	if (m_function_info_list != NULL)
+	{
+		// Build the Functions out of the info obtained from the parsing.
+		std::cout << "Building Functions..." << std::endl;
+		BuildFunctionsFromThreeAddressFormStatementLists(*m_function_info_list, function_map);
+
+		delete m_function_info_list;
+		m_function_info_list = NULL;
+
+		// The Functions now have everything they need out of the parse, and the statements
+		// belong to the ControlFlowGraph.
+		BOOST_FOREACH(ParseArena *arena, m_parse_arenas)
+		{
+			m_parent_program->GetControlFlowGraphPtr()->AdoptStatements(arena->GetStatementArena());
+		}
+		ReleaseParseArenas();
+	}
+	else
+	{
+		// The parse failed.
+
+		std::cout << "Failure: " << m_syntax_error_count << " syntax errors." << std::endl;
+	}
 }
 
 void TranslationUnit::Link(const std::map< std::string, Function* > &function_map,
@@ -213,9 +424,10 @@ void TranslationUnit::Print(ToolDot *the_dot, const boost::filesystem::path &out
 	}
 }
 
-void TranslationUnit::CompileSourceFile(const std::string& file_path, const std::string &the_filter, ToolCompiler *compiler,
+bool TranslationUnit::CompileSourceFile(const std::string& file_path, const std::string &the_filter, ToolCompiler *compiler,
 										const std::vector< std::string > &defines,
-										const std::vector< std::string > &include_paths)
+										const std::vector< std::string > &include_paths,
+										GimpleDumpBuffer *dump_contents)
 {
 	// Do the filter first.
 	/// \todo Add the prefilter functionality.
@@ -235,13 +447,97 @@ void TranslationUnit::CompileSourceFile(const std::string& file_path, const std:
 		params += " -I \"" + ip + "\"";
 	}
 	
-	// Do the compile.
-	int compile_retval = compiler->GenerateCFG(params.c_str(), file_path);
-	
-	if(compile_retval != 0)
+	// See if we already have a dump for this exact compile.
+	GimpleDumpCache *dump_cache = m_parent_program->GetGimpleDumpCache();
+	std::string cache_key;
+	if(dump_cache != NULL)
 	{
-		std::cerr << "ERROR: Compile string returned nonzero." << std::endl;
-		exit(1);
+		std::stringstream preprocessed_source;
+		if(!compiler->Preprocess(params, file_path, preprocessed_source))
+		{
+			std::cerr << "ERROR: Preprocessing \"" << file_path << "\" failed." << std::endl;
+			return false;
+		}
+
+		cache_key = GimpleDumpCache::MakeKey(preprocessed_source.str(), params, the_filter,
+				compiler->GetCommand(), compiler->GetVersion());
+
+		boost::filesystem::path cached_dump_path;
+		if(dump_cache->Lookup(cache_key, &cached_dump_path))
+		{
+			// Cache hit, no need to run the compiler.
+			return dump_contents->MapFile(cached_dump_path.generic_string());
+		}
+	}
+
+	if(m_parent_program->GetStreamGimpleDump())
+	{
+		// Have gcc send us the dump through a pipe, without creating any files at all.
+		std::stringstream dump_stream;
+		if(!compiler->GenerateCFGToStream(params, file_path, dump_stream))
+		{
+			std::cerr << "ERROR: Compile string returned nonzero." << std::endl;
+			return false;
+		}
+		std::string dump_text = dump_stream.str();
+		dump_contents->TakeString(&dump_text);
+	}
+	else
+	{
+		// Give gcc a directory of its own to write its output files into, so that we don't collide
+		// with any other compiles going on, either in this process or in another.
+		std::string scratch_dir = ToolBase::Mktemp((m_parent_program->GetTempsDir() / "coflo.XXXXXX").generic_string(), true);
+		if(scratch_dir.empty())
+		{
+			return false;
+		}
+
+		// Do the compile.
+		std::string dump_filename;
+		int compile_retval = compiler->GenerateCFG(params.c_str(), file_path, scratch_dir, &dump_filename);
+
+		bool loaded = false;
+		if(compile_retval != 0)
+		{
+			std::cerr << "ERROR: Compile string returned nonzero." << std::endl;
+		}
+		else
+		{
+			loaded = dump_contents->MapFile(dump_filename);
+		}
+
+		// We have everything we need from gcc's output files now.  The mapping of the dump
+		// stays valid after the file itself is gone.
+		RemoveScratchDirectory(scratch_dir);
+
+		if(!loaded)
+		{
+			return false;
+		}
+	}
+
+	if(dump_cache != NULL)
+	{
+		// Save the dump for next time.  Not being able to is only worth a warning.
+		dump_cache->Store(cache_key, dump_contents->GetData(), dump_contents->GetLength());
+	}
+
+	return true;
+}
+
+void TranslationUnit::RemoveScratchDirectory(const boost::filesystem::path &scratch_dir)
+{
+	if(scratch_dir.empty())
+	{
+		// Nothing to remove.
+		return;
+	}
+
+	boost::system::error_code ec;
+	boost::filesystem::remove_all(scratch_dir, ec);
+	if(ec)
+	{
+		std::cerr << "WARNING: Couldn't remove temporary directory \"" << scratch_dir.generic_string() << "\": " << ec.message() << std::endl;
 	}
 }
 
@@ -255,7 +551,7 @@ void TranslationUnit::BuildFunctionsFromThreeAddressFormStatementLists(const std
 		dlog_parse_gimple << "Processing FunctionInfo for function \"" << *(fi->m_identifier) << "\"..." << std::endl;
 
 		// Create the function.
-		Function *f = new Function(this, *(fi->m_identifier));
+		Function *f = m_parent_program->NewFunction(this, *(fi->m_identifier));
 
 		// Add the new function to the list.
 		m_function_defs.push_back(f);
@@ -265,6 +561,7 @@ void TranslationUnit::BuildFunctionsFromThreeAddressFormStatementLists(const std
 
 		// Create the control flow graph for this function.
 		f->CreateControlFlowGraph(*(m_parent_program->GetControlFlowGraphPtr()), *(fi->m_statement_list));
+
 	}
 }
 
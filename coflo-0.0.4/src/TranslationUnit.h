@@ -23,12 +23,14 @@
 #include <boost/filesystem.hpp>
 
 #include "controlflowgraph/ControlFlowGraph.h"
+#include "GimpleDumpBuffer.h"
 #include "Program.h"
 
 // Forward declarations.
 class Function;
 class FunctionCall;
 class ToolDot;
+class ParseArena;
 typedef std::vector< FunctionCallUnresolved* > T_UNRESOLVED_FUNCTION_CALL_MAP;
 struct FunctionInfo;
 
@@ -66,6 +68,64 @@ public:
 		const std::vector< std::string > &include_paths,
 		bool debug_parse = false);
 
+	/**
+	 * Compile and parse the source file, keeping the results in this TranslationUnit
+	 * until BuildFunctions() is called.
+	 *
+	 * If the Program is set to parse by function, the parse tree of each function is freed
+	 * as soon as that function has been parsed, but the FunctionInfos of the whole file are
+	 * kept until BuildFunctions(), which builds nothing unless every function parsed.
+	 *
+	 * Doesn't touch any Program-wide state, so it can be run for several
+	 * TranslationUnits at once.  Nothing is printed to stdout here; all the per-file
+	 * output is left to BuildFunctions() so that it comes out in a deterministic order.
+	 *
+	 * @param the_filter The filter command to invoke.
+	 * @param compiler The compiler command to invoke.
+	 * @param defines Vector of preprocessor defines to pass to the compiler.
+	 * @param include_paths Vector of "-I..."'s to pass to the compiler.
+	 * @param debug_parse Whether to output debugging info during the parse stage.
+	 *
+	 * @return true if the file was compiled and its GIMPLE dump loaded, false if not.
+	 */
+	bool CompileAndParse(const std::string &the_filter,
+		ToolCompiler *compiler,
+		const std::vector< std::string > &defines,
+		const std::vector< std::string > &include_paths,
+		bool debug_parse = false);
+
+	/**
+	 * @name The individual steps of CompileAndParse().
+	 *
+	 * These let the Program parse the functions of several TranslationUnits at once.  Compile()
+	 * loads the GIMPLE dump and splits it into chunks which can be parsed independently, one per
+	 * function if the Program is set to parse by function, or just the one chunk if not.
+	 * ParseDumpChunk() may then be called for the chunks in any order, from any number of threads
+	 * at once.  Once they've all been parsed, FinishParse() stitches the results back together in
+	 * source order, ready for BuildFunctions().
+	 */
+	//@{
+	bool Compile(const std::string &the_filter,
+		ToolCompiler *compiler,
+		const std::vector< std::string > &defines,
+		const std::vector< std::string > &include_paths);
+	long GetNumberOfDumpChunks() const { return m_dump_chunks.size(); };
+	void ParseDumpChunk(long chunk_index);
+	void FinishParse();
+	//@}
+
+	/**
+	 * Build the Functions found by CompileAndParse(), adding them to the program-wide
+	 * function map and ControlFlowGraph.
+	 *
+	 * Not thread-safe.  The Program calls this once per TranslationUnit, in command-line
+	 * order, so that vertex and Function creation order doesn't depend on the number of jobs.
+	 *
+	 * @param function_map Map of identifiers to Function pointers to which the
+	 *		functions found in this TranslationUnit are to be added.
+	 */
+	void BuildFunctions(T_ID_TO_FUNCTION_PTR_MAP *function_map);
+
 	/**
 	 * Link the function calls in this TranslationUnit to the Functions they call.
 	 *
@@ -88,13 +148,54 @@ private:
 	
 	/**
 	 * Compile the file with GCC to get the control flow decomposition we need.
+	 * If the Program has a GimpleDumpCache, a cached dump is used instead of running
+	 * the compiler whenever possible.  Otherwise the dump is either streamed straight from
+	 * the compiler, or read back from a scratch directory created under the Program's temps dir.
 	 * 
      * @param file_path  Path to the source file to be compiled.
+     * @param[out] dump_contents The contents of the resulting GIMPLE dump.
+     *
+     * @return true if the compile succeeded, false if it failed.
      */
-	void CompileSourceFile(const std::string& file_path, const std::string &the_filter, ToolCompiler *compiler,
+	bool CompileSourceFile(const std::string& file_path, const std::string &the_filter, ToolCompiler *compiler,
 						 const std::vector< std::string > &defines,
-						const std::vector< std::string > &include_paths);
+						const std::vector< std::string > &include_paths,
+						GimpleDumpBuffer *dump_contents);
+
+	/**
+	 * Remove a scratch directory created by CompileSourceFile(), along with everything in it.
+	 *
+	 * @param scratch_dir The directory to remove.  If empty, nothing is done.
+	 */
+	void RemoveScratchDirectory(const boost::filesystem::path &scratch_dir);
+
+	/**
+	 * Parse @a length bytes of GIMPLE at @a data with the dparser grammar.
+	 *
+	 * @param nul_terminated Whether data[length] is already a NUL.  If not, the text is copied.
+	 * @param arena The arena to allocate the results from.
+	 * @param[out] function_info_list The functions found, if the parse succeeded.
+	 * @param[in,out] syntax_error_count Incremented by the number of syntax errors found.
+	 * @return true if the parse succeeded.
+	 */
+	bool ParseWithDParser(const char *data, std::size_t length, bool nul_terminated, ParseArena *arena,
+			std::vector< FunctionInfo* > **function_info_list, long *syntax_error_count);
+
+	/// Release the GIMPLE dump and the per-chunk parse state.
+	void ReleaseDump();
+
+	/// Destroy the arenas in m_parse_arenas, and with them everything the parse produced
+	/// apart from the statements.
+	void ReleaseParseArenas();
 
+	/// Log the number of objects @a arena holds, each of which would otherwise have been
+	/// a separate trip to the heap.
+	void LogParseArenaStatistics(const ParseArena &arena) const;
+
+	/**
+	 * Create the Functions described by @a function_info_list and add their vertices to the
+	 * Program's ControlFlowGraph.
+	 */
 	void BuildFunctionsFromThreeAddressFormStatementLists(const std::vector< FunctionInfo* > &function_info_list,
 			T_ID_TO_FUNCTION_PTR_MAP *function_map);
 
@@ -106,6 +207,36 @@ private:
 
 	/// List of function definitions in this file.
 	std::vector< Function* > m_function_defs;
+
+	/// The FunctionInfos produced by CompileAndParse(), waiting for BuildFunctions().
+	/// NULL if the parse failed.
+	std::vector< FunctionInfo* > *m_function_info_list;
+
+	/// The arenas which own the contents of m_function_info_list.
+	std::vector< ParseArena* > m_parse_arenas;
+
+	/// Number of syntax errors dparser found in the GIMPLE dump.
+	long m_syntax_error_count;
+
+	/// @name Parse state between Compile() and FinishParse().
+	//@{
+
+	/// The GIMPLE dump.
+	GimpleDumpBuffer m_dump_buffer;
+
+	/// The parts of m_dump_buffer to be parsed separately.
+	std::vector< GimpleDumpChunk > m_dump_chunks;
+
+	/// The FunctionInfos found in each chunk, or NULL where the chunk failed to parse.
+	std::vector< std::vector< FunctionInfo* >* > m_chunk_function_info_lists;
+
+	/// The number of syntax errors found in each chunk.
+	std::vector< long > m_chunk_syntax_error_counts;
+
+	/// The arena each chunk's parse allocated from.
+	std::vector< ParseArena* > m_chunk_arenas;
+
+	//@}
 };
 
 #endif	/* TRANSLATIONUNIT_H */
@@ -0,0 +1,142 @@
+/*
+ * Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+ *
+ * This file is part of CoFlo.
+ *
+ * CoFlo is free software: you can redistribute it and/or modify it under the
+ * terms of version 3 of the GNU General Public License as published by the Free
+ * Software Foundation.
+ *
+ * CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file */
+
+#ifndef TYPEDARENA_HPP
+#define TYPEDARENA_HPP
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+/**
+ * An arena of objects of type T.
+ *
+ * Objects are constructed in place in large blocks, so creating one almost never involves a
+ * trip to the heap.  They can't be freed individually; they're all destroyed together when
+ * the arena is cleared or destroyed.  Objects never move once constructed.
+ *
+ * Not thread-safe.  Each thread should have its own arena.
+ *
+ * @tparam T The type of the objects in the arena.
+ */
+template < typename T >
+class TypedArena : boost::noncopyable
+{
+public:
+	/**
+	 * Constructor.
+	 *
+	 * @param objects_per_block The number of objects to allocate space for at a time.
+	 */
+	explicit TypedArena(std::size_t objects_per_block = 256) : m_objects_per_block(objects_per_block),
+			m_num_in_last_block(objects_per_block), m_num_objects(0) {};
+	~TypedArena() { Clear(); };
+
+	/// @name Object creation.
+	//@{
+	T* Construct()
+	{
+		void *slot = NextSlot();
+		T *object = new(slot) T();
+		Commit();
+		return object;
+	};
+
+	T* Construct(const T &orig)
+	{
+		void *slot = NextSlot();
+		T *object = new(slot) T(orig);
+		Commit();
+		return object;
+	};
+
+	template < typename A1, typename A2 >
+	T* Construct(const A1 &a1, const A2 &a2)
+	{
+		void *slot = NextSlot();
+		T *object = new(slot) T(a1, a2);
+		Commit();
+		return object;
+	};
+	//@}
+
+	/**
+	 * Destroy all the objects in the arena, in the reverse order of their construction, and
+	 * release the memory they occupied.
+	 */
+	void Clear()
+	{
+		while(!m_blocks.empty())
+		{
+			T *block = m_blocks.back();
+			while(m_num_in_last_block > 0)
+			{
+				--m_num_in_last_block;
+				block[m_num_in_last_block].~T();
+			}
+			::operator delete(block);
+			m_blocks.pop_back();
+			m_num_in_last_block = m_objects_per_block;
+		}
+		m_num_objects = 0;
+	};
+
+	/// @name Statistics.
+	//@{
+	std::size_t GetNumberOfObjects() const { return m_num_objects; };
+	std::size_t GetNumberOfBlocks() const { return m_blocks.size(); };
+	//@}
+
+private:
+
+	/// Return space for the next object, starting a new block if necessary.
+	void* NextSlot()
+	{
+		if(m_num_in_last_block == m_objects_per_block)
+		{
+			m_blocks.reserve(m_blocks.size() + 1);
+			m_blocks.push_back(static_cast<T*>(::operator new(sizeof(T) * m_objects_per_block)));
+			m_num_in_last_block = 0;
+		}
+		return m_blocks.back() + m_num_in_last_block;
+	};
+
+	/// Account for a successful construction in the slot returned by NextSlot().
+	void Commit()
+	{
+		++m_num_in_last_block;
+		++m_num_objects;
+	};
+
+	/// The number of objects which fit in each block.
+	std::size_t m_objects_per_block;
+
+	/// The blocks of objects.  All are full except possibly the last.
+	std::vector< T* > m_blocks;
+
+	/// The number of constructed objects in the last block.
+	std::size_t m_num_in_last_block;
+
+	/// The total number of objects constructed.
+	std::size_t m_num_objects;
+};
+
+#endif /* TYPEDARENA_HPP */
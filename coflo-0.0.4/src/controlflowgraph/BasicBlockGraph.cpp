@@ -0,0 +1,120 @@
+/*
+ * Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+ *
+ * This file is part of CoFlo.
+ *
+ * CoFlo is free software: you can redistribute it and/or modify it under the
+ * terms of version 3 of the GNU General Public License as published by the Free
+ * Software Foundation.
+ *
+ * CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file */
+
+#include "BasicBlockGraph.h"
+
+BasicBlockGraph::BasicBlockGraph(const ControlFlowGraphSnapshot &snapshot) : m_snapshot(snapshot)
+{
+	vertex_descriptor num_vertices = m_snapshot.GetNumberOfVertices();
+	std::vector<bool> continues_predecessor(num_vertices);
+
+	for(vertex_descriptor v = 0; v < num_vertices; ++v)
+	{
+		continues_predecessor[v] = ContinuesPredecessorBlock(v);
+	}
+
+	m_block_statements.reserve(num_vertices);
+	m_vertex_block.assign(num_vertices, static_cast<T_BLOCK_ID>(-1));
+
+	// Lay out the blocks in order of their leaders.
+	for(vertex_descriptor v = 0; v < num_vertices; ++v)
+	{
+		if(!continues_predecessor[v])
+		{
+			AddBlock(v, continues_predecessor);
+		}
+	}
+
+	// Anything left over is on a cycle of straight-line statements with no way in, which has no natural
+	// leader.  Unreachable, but it still needs to be in a block.
+	for(vertex_descriptor v = 0; v < num_vertices; ++v)
+	{
+		if(m_vertex_block[v] == static_cast<T_BLOCK_ID>(-1))
+		{
+			AddBlock(v, continues_predecessor);
+		}
+	}
+
+	m_block_offsets.push_back(m_block_statements.size());
+}
+
+BasicBlockGraph::~BasicBlockGraph()
+{
+}
+
+bool BasicBlockGraph::ContinuesPredecessorBlock(vertex_descriptor v) const
+{
+	in_edge_iterator ei, eend;
+	vertex_descriptor u;
+
+	if(m_snapshot.InDegree(v) != 1)
+	{
+		// No predecessor, or a join point.
+		return false;
+	}
+
+	boost::tie(ei, eend) = m_snapshot.InEdges(v);
+	if(m_snapshot.GetInEdgeKind(ei) != 0)
+	{
+		// Back edges, calls, returns etc. always cross a block boundary.
+		return false;
+	}
+
+	u = ei->m_source;
+	if(u == v || m_snapshot.OutDegree(u) != 1)
+	{
+		return false;
+	}
+
+	StatementBase *predecessor_statement = m_snapshot.GetStatementPtr(u);
+	if(predecessor_statement->IsFunctionCall() || predecessor_statement->IsDecisionStatement())
+	{
+		// These end their blocks even if they only have one way out.
+		return false;
+	}
+
+	return true;
+}
+
+void BasicBlockGraph::AddBlock(vertex_descriptor leader, const std::vector<bool> &continues_predecessor)
+{
+	T_BLOCK_ID block = m_block_offsets.size();
+	vertex_descriptor v = leader;
+
+	m_block_offsets.push_back(m_block_statements.size());
+
+	while(true)
+	{
+		m_block_statements.push_back(v);
+		m_vertex_block[v] = block;
+
+		if(m_snapshot.OutDegree(v) != 1)
+		{
+			break;
+		}
+
+		// v has a single successor.  It's the next statement of the block if it continues v's block, in
+		// which case v must be its only predecessor.
+		v = m_snapshot.OutEdges(v).first->m_target;
+		if(!continues_predecessor[v] || m_vertex_block[v] != static_cast<T_BLOCK_ID>(-1))
+		{
+			break;
+		}
+	}
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+ *
+ * This file is part of CoFlo.
+ *
+ * CoFlo is free software: you can redistribute it and/or modify it under the
+ * terms of version 3 of the GNU General Public License as published by the Free
+ * Software Foundation.
+ *
+ * CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file */
+
+#ifndef BASICBLOCKGRAPH_H
+#define BASICBLOCKGRAPH_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <boost/utility.hpp>
+#include <boost/graph/graph_traits.hpp>
+
+#include "ControlFlowGraphSnapshot.h"
+
+/**
+ * The basic blocks of a frozen control flow graph.
+ *
+ * Most statement vertices in the CFG have exactly one fallthrough in edge and one out edge, so traversals
+ * spend most of their time walking straight lines.  This class groups the vertices of a
+ * ControlFlowGraphSnapshot into maximal straight-line runs, and stores the statements of each run in one
+ * packed array.  A vertex continues its predecessor's block when it is that predecessor's only successor,
+ * the predecessor is its only predecessor, and the edge between them is a plain (not back, impossible, call,
+ * return or bypass) edge.  Function calls and decision statements always end their block, so a call's call
+ * and bypass edges, and a decision's branches, are always edges between blocks.
+ *
+ * The graph interface is the statement graph of the underlying snapshot, so existing visitors work on it
+ * unchanged.  Algorithms which know about blocks can use is_basic_block_interior() to skip bookkeeping for
+ * vertices which can only be reached from the previous statement in their block.
+ *
+ * PrintControlFlowGraph is the only user.  Reachability checking works on ControlFlowGraph::GetSlice() with
+ * ReachabilitySummaries::IsRelevantToReachability instead: a slice drops the statements reachability doesn't
+ * care about altogether, rather than only letting a traversal skip past them, and keeps every call, bypass,
+ * return and back edge between the statements it keeps, which is all the summaries need.
+ *
+ * Models the Boost Graph Library's BidirectionalGraph concept.
+ */
+class BasicBlockGraph : boost::noncopyable
+{
+public:
+
+	/// @name Boost Graph Library graph_traits<> types.
+	//@{
+	typedef ControlFlowGraphSnapshot::vertex_descriptor vertex_descriptor;
+	typedef ControlFlowGraphSnapshot::edge_descriptor edge_descriptor;
+	typedef ControlFlowGraphSnapshot::out_edge_iterator out_edge_iterator;
+	typedef ControlFlowGraphSnapshot::in_edge_iterator in_edge_iterator;
+	typedef ControlFlowGraphSnapshot::directed_category directed_category;
+	typedef ControlFlowGraphSnapshot::edge_parallel_category edge_parallel_category;
+	typedef boost::bidirectional_graph_tag traversal_category;
+	typedef ControlFlowGraphSnapshot::vertices_size_type vertices_size_type;
+	typedef ControlFlowGraphSnapshot::edges_size_type edges_size_type;
+	typedef ControlFlowGraphSnapshot::degree_size_type degree_size_type;
+
+	static vertex_descriptor null_vertex() { return ControlFlowGraphSnapshot::null_vertex(); };
+	//@}
+
+	/// Type used to number the basic blocks.
+	typedef std::size_t T_BLOCK_ID;
+
+	/**
+	 * Find the basic blocks of @a snapshot.
+	 *
+	 * @param snapshot The frozen graph to partition.  Must outlive this object.
+	 */
+	explicit BasicBlockGraph(const ControlFlowGraphSnapshot &snapshot);
+	~BasicBlockGraph();
+
+	const ControlFlowGraphSnapshot& GetSnapshot() const { return m_snapshot; };
+
+	/// @name Basic block accessors.
+	//@{
+	T_BLOCK_ID GetNumberOfBlocks() const { return m_block_offsets.size() - 1; };
+
+	/// @return The block containing vertex @a v.
+	T_BLOCK_ID GetBlock(vertex_descriptor v) const { return m_vertex_block[v]; };
+
+	/**
+	 * Return the statements of block @a b, in control flow order.
+	 *
+	 * @param b The block.
+	 * @return A [begin, end) pair of pointers into the packed statement array.
+	 */
+	std::pair<const vertex_descriptor*, const vertex_descriptor*> GetBlockStatements(T_BLOCK_ID b) const
+	{
+		return std::make_pair(&m_block_statements[0] + m_block_offsets[b], &m_block_statements[0] + m_block_offsets[b+1]);
+	};
+
+	/// @return The first statement of the block containing @a v.
+	vertex_descriptor GetBlockLeader(vertex_descriptor v) const { return m_block_statements[m_block_offsets[m_vertex_block[v]]]; };
+
+	/// @return true if @a v is the first statement of its block.  Only leaders have in edges from other blocks.
+	bool IsBlockLeader(vertex_descriptor v) const { return GetBlockLeader(v) == v; };
+	//@}
+
+	/// @name Statement graph adjacency, forwarded to the snapshot.
+	//@{
+	std::pair<out_edge_iterator, out_edge_iterator> OutEdges(vertex_descriptor v) const { return m_snapshot.OutEdges(v); };
+	std::pair<in_edge_iterator, in_edge_iterator> InEdges(vertex_descriptor v) const { return m_snapshot.InEdges(v); };
+	degree_size_type OutDegree(vertex_descriptor v) const { return m_snapshot.OutDegree(v); };
+	degree_size_type InDegree(vertex_descriptor v) const { return m_snapshot.InDegree(v); };
+	//@}
+
+private:
+
+	/**
+	 * Determine whether @a v can be placed in the same block as its predecessor.
+	 */
+	bool ContinuesPredecessorBlock(vertex_descriptor v) const;
+
+	/**
+	 * Start a new block at @a leader, and add to it every following statement which continues it.
+	 */
+	void AddBlock(vertex_descriptor leader, const std::vector<bool> &continues_predecessor);
+
+	/// The graph we partitioned.
+	const ControlFlowGraphSnapshot &m_snapshot;
+
+	/// The statements of block b are m_block_statements[m_block_offsets[b]] up to but not including
+	/// m_block_statements[m_block_offsets[b+1]].
+	std::vector<std::size_t> m_block_offsets;
+	std::vector<vertex_descriptor> m_block_statements;
+
+	/// The block each vertex is in, indexed by vertex descriptor.
+	std::vector<T_BLOCK_ID> m_vertex_block;
+};
+
+/// @name Boost Graph Library interface to BasicBlockGraph.
+//@{
+
+inline std::pair<BasicBlockGraph::out_edge_iterator, BasicBlockGraph::out_edge_iterator>
+out_edges(T_CFG_VERTEX_DESC v, const BasicBlockGraph &g)
+{
+	return g.OutEdges(v);
+}
+
+inline std::pair<BasicBlockGraph::in_edge_iterator, BasicBlockGraph::in_edge_iterator>
+in_edges(T_CFG_VERTEX_DESC v, const BasicBlockGraph &g)
+{
+	return g.InEdges(v);
+}
+
+inline T_CFG_VERTEX_DESC source(const T_CFG_EDGE_DESC &e, const BasicBlockGraph &)
+{
+	return e.m_source;
+}
+
+inline T_CFG_VERTEX_DESC target(const T_CFG_EDGE_DESC &e, const BasicBlockGraph &)
+{
+	return e.m_target;
+}
+
+inline BasicBlockGraph::degree_size_type out_degree(T_CFG_VERTEX_DESC v, const BasicBlockGraph &g)
+{
+	return g.OutDegree(v);
+}
+
+inline BasicBlockGraph::degree_size_type in_degree(T_CFG_VERTEX_DESC v, const BasicBlockGraph &g)
+{
+	return g.InDegree(v);
+}
+
+inline BasicBlockGraph::degree_size_type degree(T_CFG_VERTEX_DESC v, const BasicBlockGraph &g)
+{
+	return g.InDegree(v) + g.OutDegree(v);
+}
+
+//@}
+
+inline long filtered_in_degree(T_CFG_VERTEX_DESC v, const BasicBlockGraph &g)
+{
+	return filtered_in_degree(v, g.GetSnapshot());
+}
+
+/**
+ * Check whether @a v is inside a basic block, i.e. its only in edge comes from the previous statement of
+ * its block.  Overloads the generic version in topological_visit_kahn.h.
+ */
+inline bool is_basic_block_interior(T_CFG_VERTEX_DESC v, const BasicBlockGraph &g)
+{
+	return !g.IsBlockLeader(v);
+}
+
+#endif /* BASICBLOCKGRAPH_H */
@@ -21,10 +21,11 @@
 /// idempotent at compile time.  If it isn't, the compile will fail, alerting you to the problem.
 #include "ControlFlowGraph.h"
 
+#include <algorithm>
 #include <utility>
 #include <boost/foreach.hpp>
-#include <boost/graph/filtered_graph.hpp>
 
+#include "BasicBlockGraph.h"
 #include "visitors/BackEdgeFixupVisitor.h"
 #include "visitors/MergeNodeInsertionVisitor.h"
 #include "edges/edge_types.h"
@@ -34,53 +35,105 @@ using std::cout;
 using std::cerr;
 using std::endl;
 
-/// Property map typedef which allows us to get at the function pointer stored at
-/// CFGVertexProperties::m_containing_function in the T_CFG.
-typedef boost::property_map<T_CFG, Function* CFGVertexProperties::*>::type T_VERTEX_PROPERTY_MAP;
-
-/**
- * Predicate for filtering the CFG for only the vertices of the given function.
- */
-struct vertex_filter_predicate
+void FunctionVertexRange::Add(T_CFG_VERTEX_DESC v)
 {
-	vertex_filter_predicate()
+	if(m_first == m_end)
 	{
+		// First vertex of the function.
+		m_first = v;
+		m_end = v+1;
 	}
-	;
-	vertex_filter_predicate(T_VERTEX_PROPERTY_MAP vertex_prop_map,
-			Function *parent_function) :
-			m_vertex_prop_map(vertex_prop_map), m_parent_function(
-					parent_function)
+	else if(v == m_end && m_extra_vertices.empty())
 	{
+		// Still contiguous.
+		++m_end;
 	}
-	;
-	bool operator()(const T_CFG_VERTEX_DESC& vid) const
+	else
 	{
-		if (m_parent_function == get(m_vertex_prop_map, vid))
-		{
-			// This vertex belongs to the function we're concerned with.
-			return true;
-		}
-		else
-		{
-			return false;
-		}
+		m_extra_vertices.push_back(v);
 	}
-	;
+}
 
-	T_VERTEX_PROPERTY_MAP m_vertex_prop_map;
-	Function *m_parent_function;
-};
+std::size_t FunctionVertexRange::LocalIndex(T_CFG_VERTEX_DESC v) const
+{
+	if(v >= m_first && v < m_end)
+	{
+		return v - m_first;
+	}
+
+	std::vector<T_CFG_VERTEX_DESC>::const_iterator it;
+	it = std::lower_bound(m_extra_vertices.begin(), m_extra_vertices.end(), v);
+	if(it == m_extra_vertices.end() || *it != v)
+	{
+		// Not one of ours.
+		return Size();
+	}
+
+	return (m_end - m_first) + (it - m_extra_vertices.begin());
+}
 
 
 ControlFlowGraph::ControlFlowGraph()
 {
-
+	m_snapshot = NULL;
+	m_basic_block_graph = NULL;
 }
 
 ControlFlowGraph::~ControlFlowGraph()
 {
+	Thaw();
+}
+
+void ControlFlowGraph::Freeze()
+{
+	Thaw();
+	m_snapshot = new ControlFlowGraphSnapshot(*this);
+}
+
+void ControlFlowGraph::Thaw()
+{
+	// The blocks and slices refer to the snapshot, so they have to go first.
+	delete m_basic_block_graph;
+	m_basic_block_graph = NULL;
+	for(std::map<T_SLICE_PREDICATE, ControlFlowGraphSnapshot*>::iterator it = m_slices.begin(); it != m_slices.end(); ++it)
+	{
+		delete it->second;
+	}
+	m_slices.clear();
+	delete m_snapshot;
+	m_snapshot = NULL;
+}
+
+const ControlFlowGraphSnapshot& ControlFlowGraph::GetSnapshot()
+{
+	if(m_snapshot == NULL)
+	{
+		Freeze();
+	}
 
+	return *m_snapshot;
+}
+
+const BasicBlockGraph& ControlFlowGraph::GetBasicBlockGraph()
+{
+	if(m_basic_block_graph == NULL)
+	{
+		m_basic_block_graph = new BasicBlockGraph(GetSnapshot());
+	}
+
+	return *m_basic_block_graph;
+}
+
+const ControlFlowGraphSnapshot& ControlFlowGraph::GetSlice(T_SLICE_PREDICATE is_relevant)
+{
+	ControlFlowGraphSnapshot *&slice = m_slices[is_relevant];
+
+	if(slice == NULL)
+	{
+		slice = new ControlFlowGraphSnapshot(GetSnapshot(), is_relevant);
+	}
+
+	return *slice;
 }
 
 void ControlFlowGraph::PrintOutEdgeTypes(T_CFG_VERTEX_DESC vdesc)
@@ -90,7 +143,7 @@ void ControlFlowGraph::PrintOutEdgeTypes(T_CFG_VERTEX_DESC vdesc)
 	boost::tie(ei, eend) = boost::out_edges(vdesc, m_cfg);
 	for(;ei!=eend; ++ei)
 	{
-		std::cout << typeid(*(m_cfg[*ei].m_edge_type)).name() << std::endl;
+		std::cout << typeid(GetEdgeType(*ei)).name() << std::endl;
 	}
 }
 
@@ -101,26 +154,23 @@ void ControlFlowGraph::PrintInEdgeTypes(T_CFG_VERTEX_DESC vdesc)
 	boost::tie(ei, eend) = boost::in_edges(vdesc, m_cfg);
 	for(;ei!=eend; ++ei)
 	{
-		std::cout << typeid(*(m_cfg[*ei].m_edge_type)).name() << std::endl;
+		std::cout << typeid(GetEdgeType(*ei)).name() << std::endl;
 	}
 }
 
 void ControlFlowGraph::FixupBackEdges(Function *f)
 {
-	// Property map for getting at the edge types in the CFG.
-	T_VERTEX_PROPERTY_MAP vpm = boost::get(
-			&CFGVertexProperties::m_containing_function, m_cfg);
-	vertex_filter_predicate the_vertex_filter(vpm, f);
-	typedef boost::filtered_graph<T_CFG, boost::keep_all,
-					vertex_filter_predicate> T_FILTERED_GRAPH;
-	// Define a filtered view of only this function's CFG.
-	T_FILTERED_GRAPH graph_of_this_function(m_cfg, boost::keep_all(), the_vertex_filter);
+	// We're about to modify m_cfg directly.
+	Thaw();
+
+	// Define a view of only this function's CFG.
+	FunctionGraphView graph_of_this_function(*this, f);
 
-	std::vector<BackEdgeFixupVisitor<T_FILTERED_GRAPH>::BackEdgeFixupInfo> back_edges;
+	std::vector<BackEdgeFixupVisitor<FunctionGraphView>::BackEdgeFixupInfo> back_edges;
 
 	// Define a visitor which will find all the back edges and send back the info
 	// we need to fix them up.
-	BackEdgeFixupVisitor<T_FILTERED_GRAPH> back_edge_finder(back_edges);
+	BackEdgeFixupVisitor<FunctionGraphView> back_edge_finder(back_edges);
 
 	// Set the back_edge_finder visitor loose on the function's CFG, with its
 	// search strategy being a simple depth-first search.
@@ -129,15 +179,15 @@ void ControlFlowGraph::FixupBackEdges(Function *f)
 	boost::depth_first_search(graph_of_this_function, boost::visitor(back_edge_finder));
 
 	// Mark the edges we found as back edges.
-	BOOST_FOREACH(BackEdgeFixupVisitor<T_FILTERED_GRAPH>::BackEdgeFixupInfo fixinfo, back_edges)
+	BOOST_FOREACH(BackEdgeFixupVisitor<FunctionGraphView>::BackEdgeFixupInfo fixinfo, back_edges)
 	{
 		T_CFG_EDGE_DESC e = fixinfo.m_back_edge;
 
 		// Change this edge type to a back edge.
-		m_cfg[e].m_edge_type->MarkAsBackEdge(true);
+		m_cfg[e].m_is_back_edge = true;
 
 		// Skip the rest if this is a self edge.
-		if(fixinfo.m_impossible_target_vertex == boost::graph_traits<T_FILTERED_GRAPH>::null_vertex())
+		if(fixinfo.m_impossible_target_vertex == FunctionGraphView::null_vertex())
 		{
 			dlog_cfg << "Self edge, no further action: " << e << std::endl;
 			continue;
@@ -152,7 +202,7 @@ void ControlFlowGraph::FixupBackEdges(Function *f)
 			T_CFG_EDGE_DESC newedge;
 			boost::tie(newedge, boost::tuples::ignore) =
 					boost::add_edge(src, fixinfo.m_impossible_target_vertex, m_cfg);
-			m_cfg[newedge].m_edge_type = new CFGEdgeTypeImpossible;
+			m_cfg[newedge].SetEdgeKind(CFGEdgeKind::impossible);
 
 			dlog_cfg << "Retargetting back edge " << e << " to " << fixinfo.m_impossible_target_vertex << std::endl;
 		}
@@ -164,23 +214,20 @@ void ControlFlowGraph::FixupBackEdges(Function *f)
 
 void ControlFlowGraph::InsertMergeNodes(Function *f)
 {
-	// Property map for getting at the edge types in the CFG.
-	T_VERTEX_PROPERTY_MAP vpm = boost::get(
-			&CFGVertexProperties::m_containing_function, m_cfg);
-	vertex_filter_predicate the_vertex_filter(vpm, f);
-	typedef boost::filtered_graph<T_CFG, boost::keep_all,
-					vertex_filter_predicate> T_FILTERED_GRAPH;
-	// Define a filtered view of only this function's CFG.
-	T_FILTERED_GRAPH graph_of_this_function(m_cfg, boost::keep_all(), the_vertex_filter);
+	// We're about to modify m_cfg directly.
+	Thaw();
 
-	std::vector<MergeNodeInsertionVisitor<T_FILTERED_GRAPH>::MergeInsertionInfo> returned_merge_info;
+	// Define a view of only this function's CFG.
+	FunctionGraphView graph_of_this_function(*this, f);
 
-	MergeNodeInsertionVisitor<T_FILTERED_GRAPH> mni_visitor(&returned_merge_info);
+	std::vector<MergeNodeInsertionVisitor<FunctionGraphView>::MergeInsertionInfo> returned_merge_info;
+
+	MergeNodeInsertionVisitor<FunctionGraphView> mni_visitor(&returned_merge_info);
 
 	boost::depth_first_search(graph_of_this_function, boost::visitor(mni_visitor));
 
 	cout << "Returned Merge info:" << endl;
-	BOOST_FOREACH(MergeNodeInsertionVisitor<T_FILTERED_GRAPH>::MergeInsertionInfo mi, returned_merge_info)
+	BOOST_FOREACH(MergeNodeInsertionVisitor<FunctionGraphView>::MergeInsertionInfo mi, returned_merge_info)
 	{
 		cout << "MI:" << endl;
 		BOOST_FOREACH(T_CFG_EDGE_DESC e, mi.m_terminal_edges)
@@ -191,11 +238,12 @@ void ControlFlowGraph::InsertMergeNodes(Function *f)
 
 	// Now modify the tree.
 	T_CFG_EDGE_DESC last_merge_vertex_out_edge;
-	BOOST_FOREACH(MergeNodeInsertionVisitor<T_FILTERED_GRAPH>::MergeInsertionInfo mii, returned_merge_info)
+	BOOST_FOREACH(MergeNodeInsertionVisitor<FunctionGraphView>::MergeInsertionInfo mii, returned_merge_info)
 	{
 		T_CFG_VERTEX_DESC merge_vertex, last_merge_vertex;
 		T_CFG_EDGE_DESC new_edge, last_merge_edge;
-		CFGEdgeTypeBase *new_edge_type;
+		// The first edge added takes over the properties of the first terminal edge, the rest get the defaults.
+		bool copy_last_merge_edge_properties = true;
 
 		if(mii.m_terminal_edges.size() < 3)
 		{
@@ -208,37 +256,39 @@ void ControlFlowGraph::InsertMergeNodes(Function *f)
 		eend = mii.m_terminal_edges.end();
 		last_merge_edge = *eit;
 		last_merge_vertex = boost::source(last_merge_edge, m_cfg);
-		new_edge_type = m_cfg[last_merge_edge].m_edge_type;
 		++eit;
 		for(; eit+1 != eend; ++eit)
 		{
 			std::cout << "INFO: Inserting Merge vertex, in edges=" << endl;
 			cout << *eit << endl;
-			merge_vertex = boost::add_vertex(m_cfg);
-			m_cfg[merge_vertex].m_statement = new Merge(Location("[UNKNOWN : 0]"));
-			m_cfg[merge_vertex].m_containing_function = f;
+			merge_vertex = AddVertex(NewStatement<Merge>(Location()), f);
 
 			// Add the in-edges.
 			boost::tie(new_edge, boost::tuples::ignore) = boost::add_edge(last_merge_vertex, merge_vertex, m_cfg);
-			m_cfg[new_edge].m_edge_type = new_edge_type;
+			if(copy_last_merge_edge_properties)
+			{
+				CopyEdgeProperties(last_merge_edge, new_edge);
+				copy_last_merge_edge_properties = false;
+			}
 			cout << " " << last_merge_vertex << "->" << merge_vertex << std::endl;
 			boost::tie(new_edge, boost::tuples::ignore) = boost::add_edge(boost::source(*eit, m_cfg), merge_vertex, m_cfg);
-			m_cfg[new_edge].m_edge_type = m_cfg[*eit].m_edge_type;
+			CopyEdgeProperties(*eit, new_edge);
 			cout << " " << boost::source(*eit, m_cfg) << "->" << merge_vertex << std::endl;
 
 			last_merge_vertex = merge_vertex;
-
-			new_edge_type = new CFGEdgeTypeFallthrough();
 		}
 
 		// Now add the final out edge of the last merge vertex added above.
 		boost::tie(new_edge, boost::tuples::ignore) = boost::add_edge(last_merge_vertex, boost::target(*eit, m_cfg), m_cfg);
-		m_cfg[new_edge].m_edge_type = new_edge_type;
+		if(copy_last_merge_edge_properties)
+		{
+			CopyEdgeProperties(last_merge_edge, new_edge);
+		}
 		cout << " Target=" << last_merge_vertex << "->" << boost::target(*eit, m_cfg) << endl;
 	}
 
 	// Now remove all the old edges which are now invalid.
-	BOOST_FOREACH(MergeNodeInsertionVisitor<T_FILTERED_GRAPH>::MergeInsertionInfo mii, returned_merge_info)
+	BOOST_FOREACH(MergeNodeInsertionVisitor<FunctionGraphView>::MergeInsertionInfo mii, returned_merge_info)
 	{
 		std::vector<T_CFG_EDGE_DESC>::iterator eit, eend;
 		eit = mii.m_terminal_edges.begin();
@@ -253,29 +303,26 @@ void ControlFlowGraph::InsertMergeNodes(Function *f)
 
 void ControlFlowGraph::SplitCriticalEdges(Function *f)
 {
-	// Property map for getting at the edge types in the CFG.
-	T_VERTEX_PROPERTY_MAP vpm = boost::get(
-			&CFGVertexProperties::m_containing_function, m_cfg);
-	vertex_filter_predicate the_vertex_filter(vpm, f);
-	typedef boost::filtered_graph<T_CFG, boost::keep_all,
-					vertex_filter_predicate> T_FILTERED_GRAPH;
-	// Define a filtered view of only this function's CFG.
-	T_FILTERED_GRAPH graph_of_this_function(m_cfg, boost::keep_all(), the_vertex_filter);
+	// We're about to modify m_cfg directly.
+	Thaw();
+
+	// Define a view of only this function's CFG.
+	FunctionGraphView graph_of_this_function(*this, f);
 
 	std::vector<T_CFG_EDGE_DESC> edges_to_remove;
 
 	// Find any critical edges and split them by inserting NOOPs.
-	boost::graph_traits<T_FILTERED_GRAPH>::edge_iterator eit, eend;
+	FunctionGraphView::edge_iterator eit, eend;
 
-	boost::tie(eit, eend) = boost::edges(graph_of_this_function);
+	boost::tie(eit, eend) = edges(graph_of_this_function);
 	for (; eit != eend; ++eit)
 	{
 		T_CFG_VERTEX_DESC source_vertex_desc, target_vertex_desc;
 		long target_id, source_od;
 
 		// Get the vertex descriptors.
-		source_vertex_desc = boost::source(*eit, graph_of_this_function);
-		target_vertex_desc = boost::target(*eit, graph_of_this_function);
+		source_vertex_desc = source(*eit, graph_of_this_function);
+		target_vertex_desc = target(*eit, graph_of_this_function);
 
 		// Get the effective in and out degrees.
 		/// @todo
@@ -298,28 +345,26 @@ void ControlFlowGraph::SplitCriticalEdges(Function *f)
 		T_CFG_VERTEX_DESC source_vertex_desc, target_vertex_desc, splitting_vertex;
 
 		// Get the vertex descriptors.
-		source_vertex_desc = boost::source(e, graph_of_this_function);
-		target_vertex_desc = boost::target(e, graph_of_this_function);
+		source_vertex_desc = source(e, graph_of_this_function);
+		target_vertex_desc = target(e, graph_of_this_function);
 
 		// Create the new NoOp vertex.
-		splitting_vertex = boost::add_vertex(m_cfg);
-		m_cfg[splitting_vertex].m_statement = new NoOp(Location("[UNKNOWN : 0]"));
-		m_cfg[splitting_vertex].m_containing_function = f;
+		splitting_vertex = AddVertex(NewStatement<NoOp>(Location()), f);
 
 		// Split the edge by pointing the old edge at the new vertex, and a new fallthrough
 		// edge from the new vertex to the old target.
 		T_CFG_EDGE_DESC new_edge_1, new_edge_2;
 		boost::tie(new_edge_1, boost::tuples::ignore) = boost::add_edge(source_vertex_desc, splitting_vertex, m_cfg);
 		boost::tie(new_edge_2, boost::tuples::ignore) = boost::add_edge(splitting_vertex, target_vertex_desc, m_cfg);
-		m_cfg[new_edge_1].m_edge_type = m_cfg[e].m_edge_type;
-		m_cfg[e].m_edge_type = NULL;
-		m_cfg[new_edge_2].m_edge_type = new CFGEdgeTypeFallthrough();
-		boost::remove_edge(e, m_cfg);
+		CopyEdgeProperties(e, new_edge_1);
+		m_cfg[new_edge_2].SetEdgeKind(CFGEdgeKind::fallthrough);
+		RemoveEdge(e);
 	}
 }
 
 void ControlFlowGraph::AddEdge(const T_CFG_VERTEX_DESC & source, const T_CFG_VERTEX_DESC & target)
 {
+	Thaw();
 	boost::add_edge(source, target, m_cfg);
 }
 
@@ -332,31 +377,86 @@ T_CFG_VERTEX_DESC ControlFlowGraph::AddVertex(StatementBase *statement, Function
 {
 	T_CFG_VERTEX_DESC retval;
 
+	Thaw();
 	retval = boost::add_vertex(m_cfg);
 	m_cfg[retval].m_statement = statement;
 	m_cfg[retval].m_containing_function = containing_function;
+	m_function_vertex_ranges[containing_function].Add(retval);
 
 	return retval;
+}
+
+const FunctionVertexRange& ControlFlowGraph::GetFunctionVertexRange(const Function *f) const
+{
+	static const FunctionVertexRange f_empty_range;
+	boost::unordered_map<const Function*, FunctionVertexRange>::const_iterator it;
+
+	it = m_function_vertex_ranges.find(f);
+	if(it == m_function_vertex_ranges.end())
+	{
+		return f_empty_range;
+	}
+
+	return it->second;
 }
 
-T_CFG_EDGE_DESC ControlFlowGraph::AddEdge(const T_CFG_VERTEX_DESC & source, const T_CFG_VERTEX_DESC & target, CFGEdgeTypeBase *edge_type)
+T_CFG_EDGE_DESC ControlFlowGraph::AddEdge(const T_CFG_VERTEX_DESC & source, const T_CFG_VERTEX_DESC & target, CFGEdgeKind kind,
+		FunctionCallResolved *function_call)
 {
 	T_CFG_EDGE_DESC eid;
 	bool ok;
 
+	Thaw();
 	boost::tie(eid, ok) = boost::add_edge(source, target, m_cfg);
-	// Since this edge is within the block, it is just a fallthrough.
-	m_cfg[eid].m_edge_type = edge_type;
+	m_cfg[eid].SetEdgeKind(kind);
+
+	if(function_call != NULL)
+	{
+		m_edge_function_calls[eid] = function_call;
+	}
 
 	return eid;
+}
+
+FunctionCallResolved* ControlFlowGraph::GetEdgeFunctionCall(T_CFG_EDGE_DESC e) const
+{
+	std::map<T_CFG_EDGE_DESC, FunctionCallResolved*>::const_iterator it;
+
+	it = m_edge_function_calls.find(e);
+	if(it == m_edge_function_calls.end())
+	{
+		// Not a call or return edge.
+		return NULL;
+	}
+
+	return it->second;
 }
 
 void ControlFlowGraph::ChangeEdgeSource(T_CFG_EDGE_DESC & e, const T_CFG_VERTEX_DESC & source)
 {
 }
 
+void ControlFlowGraph::CopyEdgeProperties(const T_CFG_EDGE_DESC & from, const T_CFG_EDGE_DESC & to)
+{
+	Thaw();
+	m_cfg[to] = m_cfg[from];
+
+	// The call a call or return edge belongs to isn't in its properties, so it has to be copied separately.
+	std::map<T_CFG_EDGE_DESC, FunctionCallResolved*>::const_iterator it = m_edge_function_calls.find(from);
+	if(it != m_edge_function_calls.end())
+	{
+		m_edge_function_calls[to] = it->second;
+	}
+	else
+	{
+		m_edge_function_calls.erase(to);
+	}
+}
+
 void ControlFlowGraph::RemoveEdge(const T_CFG_EDGE_DESC & e)
 {
+	Thaw();
+	m_edge_function_calls.erase(e);
 	boost::remove_edge(e, m_cfg);
 }
 
@@ -20,14 +20,22 @@
 #ifndef CONTROLFLOWGRAPH_H
 #define	CONTROLFLOWGRAPH_H
 
+#include <cstddef>
+#include <map>
+#include <vector>
+
 #include <boost/graph/graph_traits.hpp>
 #include <boost/graph/adjacency_list.hpp>
 #include <boost/utility.hpp>
+#include <boost/unordered_map.hpp>
 
+#include "../ObjectArena.hpp"
 #include "statements/statements.h"
 #include "edges/CFGEdgeTypeBase.h"
 
 class Function;
+class ControlFlowGraphSnapshot;
+class BasicBlockGraph;
 
 
 /// @name Control Flow Graph definitions.
@@ -46,9 +54,20 @@ struct CFGVertexProperties
 /// Edge properties for the CFG graph.
 struct CFGEdgeProperties
 {
-	/// The Edge Type.
-	/// May be a FunctionCall, fallthrough, goto, etc.
-	CFGEdgeTypeBase *m_edge_type;
+	CFGEdgeProperties() : m_edge_kind(CFGEdgeKind::fallthrough), m_is_back_edge(false) {};
+
+	CFGEdgeKind GetEdgeKind() const { return static_cast<CFGEdgeKind::value_type>(m_edge_kind); };
+	void SetEdgeKind(CFGEdgeKind kind) { m_edge_kind = kind.as_enum(); };
+
+	/// The Edge Kind.
+	/// May be a FunctionCall, fallthrough, goto, etc.  Holds a CFGEdgeKind::value_type, kept in
+	/// a single byte since there's one of these for every edge in the program.
+	unsigned char m_edge_kind;
+
+	/// true if this edge has been determined to be a back edge, as would be caused by a loop.
+	/// We keep this info around because we need it for doing certain operations such as
+	/// topological sorting, and we want to just determine it once.
+	bool m_is_back_edge;
 };
 
 /// Typedef for the CFG graph.
@@ -84,8 +103,10 @@ typedef boost::graph_traits< T_CFG >::in_edge_iterator T_CFG_IN_EDGE_ITERATOR;
 /// Typedef for the type used to represent vertex degrees.
 typedef boost::graph_traits< T_CFG >::degree_size_type T_CFG_DEGREE_SIZE_TYPE;
 
-template < typename CFGEdgeType >
-boost::tuple<T_CFG_EDGE_DESC, bool> GetFirstOutEdgeOfType(T_CFG_VERTEX_DESC vdesc, const T_CFG &cfg)
+/// Typedef for the predicates which decide which statements an analysis needs to see, for slicing the CFG.
+typedef bool (*T_SLICE_PREDICATE)(StatementBase *statement);
+
+inline boost::tuple<T_CFG_EDGE_DESC, bool> GetFirstOutEdgeOfKind(T_CFG_VERTEX_DESC vdesc, CFGEdgeKind kind, const T_CFG &cfg)
 {
 	boost::graph_traits< T_CFG >::out_edge_iterator eit, eend;
 	boost::tuple<T_CFG_EDGE_DESC, bool> retval;
@@ -93,7 +114,7 @@ boost::tuple<T_CFG_EDGE_DESC, bool> GetFirstOutEdgeOfType(T_CFG_VERTEX_DESC vdes
 	boost::tie(eit, eend) = boost::out_edges(vdesc, cfg);
 	for(; eit != eend; eit++)
 	{
-		if(NULL != dynamic_cast<CFGEdgeType*>(cfg[*eit].m_edge_type))
+		if(cfg[*eit].GetEdgeKind() == kind)
 		{
 			// Found it.
 			retval = boost::make_tuple(*eit, true);
@@ -106,6 +127,57 @@ boost::tuple<T_CFG_EDGE_DESC, bool> GetFirstOutEdgeOfType(T_CFG_VERTEX_DESC vdes
 	return retval;
 }
 
+/**
+ * The set of vertices in a T_CFG which belong to one Function.
+ *
+ * Function::CreateControlFlowGraph() adds all of a function's vertices in one go, and T_CFG's vecS vertex
+ * storage hands out consecutive descriptors, so almost all of a function's vertices form a single contiguous
+ * run [first, end).  Vertices added to the function later on (Merge and NoOp vertices) land at the end of the
+ * whole-program graph, after other functions' vertices; those are kept in a short sorted side list.
+ *
+ * Positions 0..Size()-1 number the function's vertices densely, contiguous run first.
+ */
+class FunctionVertexRange
+{
+public:
+	FunctionVertexRange() : m_first(0), m_end(0) {};
+
+	/**
+	 * Record @a v as belonging to this function.  Vertices must be added in increasing descriptor order,
+	 * as boost::add_vertex() creates them.
+	 */
+	void Add(T_CFG_VERTEX_DESC v);
+
+	/// @return The number of vertices in the function.
+	std::size_t Size() const { return (m_end - m_first) + m_extra_vertices.size(); };
+
+	/// @return The vertex at position @a i.
+	T_CFG_VERTEX_DESC operator[](std::size_t i) const
+	{
+		std::size_t contiguous_size = m_end - m_first;
+		return (i < contiguous_size) ? (m_first + i) : m_extra_vertices[i - contiguous_size];
+	};
+
+	/**
+	 * Return the position of vertex @a v.
+	 *
+	 * @param v The vertex to look up.
+	 * @return The position of @a v, or Size() if @a v doesn't belong to the function.
+	 */
+	std::size_t LocalIndex(T_CFG_VERTEX_DESC v) const;
+
+private:
+
+	/// The first vertex of the contiguous run.
+	T_CFG_VERTEX_DESC m_first;
+
+	/// One past the last vertex of the contiguous run.
+	T_CFG_VERTEX_DESC m_end;
+
+	/// Vertices added after the contiguous run was broken, in increasing order.
+	std::vector<T_CFG_VERTEX_DESC> m_extra_vertices;
+};
+
 
 
 
@@ -131,7 +203,57 @@ public:
 	 */
 	const T_CFG& GetConstT_CFG() const { return m_cfg; };
 
-	T_CFG& GetT_CFG() { return m_cfg; };
+	/**
+	 * Non-const version of GetConstT_CFG().  Since the caller may modify the graph through the returned
+	 * reference, this discards any frozen snapshot.
+	 *
+	 * @deprecated See GetConstT_CFG().
+	 */
+	T_CFG& GetT_CFG() { Thaw(); return m_cfg; };
+
+	/// @name Frozen snapshot
+	/// Once the graph is fully built and linked, it can be frozen into a ControlFlowGraphSnapshot, a
+	/// read-only compressed-sparse-row copy which whole-program traversals run on.  Any modification made
+	/// through this class discards the snapshot.  Code holding on to a raw T_CFG pointer must finish
+	/// modifying the graph before it is frozen.
+	//@{
+
+	/**
+	 * Build the snapshot of the graph in its current state, replacing any previous one.
+	 */
+	void Freeze();
+
+	/**
+	 * Discard the snapshot, if there is one.
+	 */
+	void Thaw();
+
+	/**
+	 * Return the snapshot of the graph, freezing it first if necessary.
+	 *
+	 * @return Reference to the snapshot.  Invalidated by the next modification of the graph.
+	 */
+	const ControlFlowGraphSnapshot& GetSnapshot();
+
+	bool IsFrozen() const { return m_snapshot != NULL; };
+
+	/**
+	 * Return the basic blocks of the snapshot, freezing the graph first if necessary.
+	 *
+	 * @return Reference to the BasicBlockGraph.  Invalidated along with the snapshot.
+	 */
+	const BasicBlockGraph& GetBasicBlockGraph();
+
+	/**
+	 * Return the slice of the snapshot keeping only the statements which @a is_relevant accepts, freezing
+	 * the graph first if necessary.  Slices are built on first use and kept until the graph is modified.
+	 *
+	 * @param is_relevant The predicate selecting the statements the analysis needs.
+	 * @return Reference to the slice.  Invalidated along with the snapshot.
+	 */
+	const ControlFlowGraphSnapshot& GetSlice(T_SLICE_PREDICATE is_relevant);
+
+	//@}
 
 	/// @name Graph construction helpers
 	//@{
@@ -156,8 +278,53 @@ public:
 	void PrintInEdgeTypes(T_CFG_VERTEX_DESC vdesc);
 	//@}
 
+	/// @name Statement ownership
+	/// The graph owns every statement at its vertices, and destroys them all at once when it's destroyed.
+	//@{
+	/// Construct a statement in the graph's statement arena.
+	template < typename T, typename A1 >
+	T* NewStatement(const A1 &a1) { return m_statements.New<T>(a1); };
+	template < typename T, typename A1, typename A2 >
+	T* NewStatement(const A1 &a1, const A2 &a2) { return m_statements.New<T>(a1, a2); };
+
+	/**
+	 * Take over the statements in @a arena, which the parser allocated them from.  They stay where they
+	 * are in memory, so each function's statements remain together.
+	 *
+	 * @param arena The arena to take the statements from.  It's left empty.
+	 */
+	void AdoptStatements(ObjectArena *arena) { m_statements.Adopt(arena); };
+	//@}
+
+	/**
+	 * Add a vertex for @a statement to the graph and record it as belonging to @a containing_function.
+	 *
+	 * @param statement The Statement at the new vertex.
+	 * @param containing_function The Function the new vertex belongs to.
+	 * @return The new vertex.
+	 */
 	T_CFG_VERTEX_DESC AddVertex(StatementBase * statement, Function *containing_function);
-	T_CFG_EDGE_DESC AddEdge(const T_CFG_VERTEX_DESC &source, const T_CFG_VERTEX_DESC &target, CFGEdgeTypeBase *edge_type);
+
+	/**
+	 * Return the vertices belonging to Function @a f.  FunctionGraphView uses this to restrict per-function
+	 * passes to just that function's vertices.
+	 *
+	 * @param f The Function to look up.
+	 * @return The vertices added for @a f via AddVertex(), which is empty if there are none.
+	 */
+	const FunctionVertexRange& GetFunctionVertexRange(const Function *f) const;
+
+	/**
+	 * Add an edge of kind @a kind between the given source and target vertices.
+	 *
+	 * @param source Source vertex descriptor.
+	 * @param target Target vertex descriptor.
+	 * @param kind The kind of edge to add.
+	 * @param function_call For function_call and function_return edges, the FunctionCallResolved the edge belongs to.
+	 * @return The new edge.
+	 */
+	T_CFG_EDGE_DESC AddEdge(const T_CFG_VERTEX_DESC &source, const T_CFG_VERTEX_DESC &target, CFGEdgeKind kind,
+			FunctionCallResolved *function_call = NULL);
 
 	/// @name Edge attribute accessors.
 	//@{
@@ -178,13 +345,25 @@ public:
 	 */
 	T_CFG_VERTEX_DESC Target(T_CFG_EDGE_DESC e) { return boost::target(e, m_cfg); };
 
+	CFGEdgeKind GetEdgeKind(T_CFG_EDGE_DESC e) const { return m_cfg[e].GetEdgeKind(); };
+
+	bool IsBackEdge(T_CFG_EDGE_DESC e) const { return m_cfg[e].m_is_back_edge; };
+
+	/**
+	 * Returns the CFGEdgeTypeBase-derived edge type object describing edge @a e.
+	 *
+	 * @param e The graph edge to examine.
+	 * @return Reference to the shared edge type object for the kind of edge @a e.
+	 */
+	const CFGEdgeTypeBase& GetEdgeType(T_CFG_EDGE_DESC e) const { return CFGEdgeTypeBase::GetEdgeType(m_cfg[e].GetEdgeKind()); };
+
 	/**
-	 * Returns a pointer to the CFGEdgeTypeBase-derived edge type class associated with edge @a e.
+	 * Returns the FunctionCallResolved which a function_call or function_return edge was created for.
 	 *
 	 * @param e The graph edge to examine.
-	 * @return Pointer to the CFGEdgeTypeBase-derived edge type class associated with edge @a e.
+	 * @return The FunctionCallResolved, or NULL if @a e isn't a call or return edge.
 	 */
-	CFGEdgeTypeBase* GetEdgeTypePtr(T_CFG_EDGE_DESC e) { return m_cfg[e].m_edge_type; };
+	FunctionCallResolved* GetEdgeFunctionCall(T_CFG_EDGE_DESC e) const;
 
 	//@}
 
@@ -212,13 +391,41 @@ private:
 	 */
 	void AddEdge(const T_CFG_VERTEX_DESC &source, const T_CFG_VERTEX_DESC &target);
 	void RemoveEdge(const T_CFG_EDGE_DESC &e);
+
+	/**
+	 * Give edge @a to the same properties as edge @a from, including the FunctionCallResolved
+	 * a call or return edge belongs to.
+	 *
+	 * @param from The edge to copy the properties of.
+	 * @param to The edge to copy them to.
+	 */
+	void CopyEdgeProperties(const T_CFG_EDGE_DESC &from, const T_CFG_EDGE_DESC &to);
 	void ChangeEdgeTarget(T_CFG_EDGE_DESC &e, const T_CFG_VERTEX_DESC &target);
 	void ChangeEdgeSource(T_CFG_EDGE_DESC &e, const T_CFG_VERTEX_DESC &source);
 
 	//@}
 
+	/// The statements at the vertices.  Declared first so it's destroyed last, after everything which points into it.
+	ObjectArena m_statements;
+
 	/// The Boost Graph Library graph we'll use for our underlying graph implementation.
 	T_CFG m_cfg;
+
+	/// Side table of the FunctionCallResolved each call and return edge belongs to.
+	/// Only a small fraction of edges have one, so we don't spend space on it in every CFGEdgeProperties.
+	std::map<T_CFG_EDGE_DESC, FunctionCallResolved*> m_edge_function_calls;
+
+	/// The vertices of each Function in the graph.
+	boost::unordered_map<const Function*, FunctionVertexRange> m_function_vertex_ranges;
+
+	/// The frozen copy of m_cfg, or NULL if the graph isn't currently frozen.
+	ControlFlowGraphSnapshot *m_snapshot;
+
+	/// The basic blocks of m_snapshot, or NULL if they haven't been needed since it was built.
+	BasicBlockGraph *m_basic_block_graph;
+
+	/// The slices of m_snapshot built so far, by predicate.
+	std::map<T_SLICE_PREDICATE, ControlFlowGraphSnapshot*> m_slices;
 };
 
 //@}
@@ -228,6 +435,8 @@ private:
 //@{
 #include "visitors/ControlFlowGraphVisitorBase.h"
 #include "topological_visit_kahn.h"
+#include "ControlFlowGraphSnapshot.h"
+#include "FunctionGraphView.h"
 //@}
 
 #endif	/* CONTROLFLOWGRAPH_H */
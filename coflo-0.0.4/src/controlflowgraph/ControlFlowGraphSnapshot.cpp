@@ -0,0 +1,246 @@
+/*
+ * Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+ *
+ * This file is part of CoFlo.
+ *
+ * CoFlo is free software: you can redistribute it and/or modify it under the
+ * terms of version 3 of the GNU General Public License as published by the Free
+ * Software Foundation.
+ *
+ * CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file */
+
+#include "ControlFlowGraphSnapshot.h"
+
+#include <iostream>
+
+ControlFlowGraphSnapshot::ControlFlowGraphSnapshot(const ControlFlowGraph &control_flow_graph)
+{
+	T_CFG_VERTEX_ITERATOR vit, vend;
+	T_CFG_OUT_EDGE_ITERATOR oeit, oeend;
+	T_CFG_IN_EDGE_ITERATOR ieit, ieend;
+	T_EDGE_KIND kind;
+
+	const T_CFG &cfg = control_flow_graph.GetConstT_CFG();
+
+	std::size_t num_vertices = boost::num_vertices(cfg);
+	std::size_t num_edges = boost::num_edges(cfg);
+
+	m_statements.reserve(num_vertices);
+	m_out_offsets.reserve(num_vertices+1);
+	m_in_offsets.reserve(num_vertices+1);
+	m_out_edges.reserve(num_edges);
+	m_out_edge_kinds.reserve(num_edges);
+	m_out_edge_function_calls.reserve(num_edges);
+	m_in_edges.reserve(num_edges);
+	m_in_edge_kinds.reserve(num_edges);
+
+	// T_CFG uses vecS vertex storage, so vertex descriptors are already the dense indices 0..N-1
+	// we need, and iterating over the vertices visits them in that order.
+	for(boost::tie(vit, vend) = boost::vertices(cfg); vit != vend; ++vit)
+	{
+		m_statements.push_back(cfg[*vit].m_statement);
+
+		m_out_offsets.push_back(m_out_edges.size());
+		for(boost::tie(oeit, oeend) = boost::out_edges(*vit, cfg); oeit != oeend; ++oeit)
+		{
+			kind = ClassifyEdge(cfg[*oeit]);
+			m_out_edges.push_back(*oeit);
+			m_out_edge_kinds.push_back(kind);
+			if(kind & (EDGE_KIND_FUNCTION_CALL | EDGE_KIND_RETURN))
+			{
+				m_out_edge_function_calls.push_back(control_flow_graph.GetEdgeFunctionCall(*oeit));
+			}
+			else
+			{
+				m_out_edge_function_calls.push_back(NULL);
+			}
+		}
+
+		m_in_offsets.push_back(m_in_edges.size());
+		for(boost::tie(ieit, ieend) = boost::in_edges(*vit, cfg); ieit != ieend; ++ieit)
+		{
+			m_in_edges.push_back(*ieit);
+			m_in_edge_kinds.push_back(ClassifyEdge(cfg[*ieit]));
+		}
+	}
+
+	// The sentinel offsets marking the end of the last vertex's edges.
+	m_out_offsets.push_back(m_out_edges.size());
+	m_in_offsets.push_back(m_in_edges.size());
+
+	ComputeFilteredDegrees();
+}
+
+ControlFlowGraphSnapshot::ControlFlowGraphSnapshot(const ControlFlowGraphSnapshot &graph, T_SLICE_PREDICATE is_relevant)
+{
+	out_edge_iterator oeit, oeend;
+	T_CFG_VERTEX_DESC v, w;
+
+	std::size_t num_vertices = graph.GetNumberOfVertices();
+	std::vector<bool> keep(num_vertices);
+
+	m_statements = graph.m_statements;
+
+	// Decide which vertices stay.
+	for(v = 0; v < num_vertices; ++v)
+	{
+		if(is_relevant(m_statements[v]) || (graph.OutDegree(v) != 1))
+		{
+			keep[v] = true;
+		}
+		else
+		{
+			boost::tie(oeit, oeend) = graph.OutEdges(v);
+			keep[v] = (graph.GetOutEdgeKind(oeit) != 0) || (oeit->m_target == v);
+		}
+	}
+
+	// Build the forward adjacency, splicing out the vertices we're not keeping.
+	m_out_offsets.reserve(num_vertices+1);
+	for(v = 0; v < num_vertices; ++v)
+	{
+		m_out_offsets.push_back(m_out_edges.size());
+
+		if(!keep[v])
+		{
+			continue;
+		}
+
+		for(boost::tie(oeit, oeend) = graph.OutEdges(v); oeit != oeend; ++oeit)
+		{
+			std::size_t num_spliced = 0;
+
+			w = oeit->m_target;
+			while(!keep[w])
+			{
+				// w has exactly one out edge, and it's a plain one.  Step over w.
+				w = graph.OutEdges(w).first->m_target;
+
+				if(++num_spliced > num_vertices)
+				{
+					// Only possible with a cycle of plain edges, which FixupBackEdges() should have broken.
+					std::cerr << "ERROR: Cycle with no back edge found while slicing the CFG at vertex " << v << "." << std::endl;
+					break;
+				}
+			}
+
+			m_out_edges.push_back(T_CFG_EDGE_DESC(v, w, oeit->get_property()));
+			m_out_edge_kinds.push_back(graph.GetOutEdgeKind(oeit));
+			m_out_edge_function_calls.push_back(graph.GetOutEdgeFunctionCall(oeit));
+		}
+	}
+	m_out_offsets.push_back(m_out_edges.size());
+
+	// Build the reverse adjacency from the forward one.  First count each vertex's in edges...
+	m_in_offsets.assign(num_vertices+1, 0);
+	for(std::size_t i = 0; i < m_out_edges.size(); ++i)
+	{
+		++m_in_offsets[m_out_edges[i].m_target + 1];
+	}
+	for(v = 0; v < num_vertices; ++v)
+	{
+		m_in_offsets[v+1] += m_in_offsets[v];
+	}
+
+	// ...then drop each edge into its target's range.
+	std::vector<std::size_t> next_in_edge(m_in_offsets.begin(), m_in_offsets.end()-1);
+	m_in_edges.resize(m_out_edges.size());
+	m_in_edge_kinds.resize(m_out_edges.size());
+	for(std::size_t i = 0; i < m_out_edges.size(); ++i)
+	{
+		std::size_t pos = next_in_edge[m_out_edges[i].m_target]++;
+		m_in_edges[pos] = m_out_edges[i];
+		m_in_edge_kinds[pos] = m_out_edge_kinds[i];
+	}
+
+	ComputeFilteredDegrees();
+}
+
+ControlFlowGraphSnapshot::~ControlFlowGraphSnapshot()
+{
+}
+
+ControlFlowGraphSnapshot::T_EDGE_KIND ControlFlowGraphSnapshot::ClassifyEdge(const CFGEdgeProperties &edge_properties)
+{
+	T_EDGE_KIND kind = 0;
+
+	if(edge_properties.m_is_back_edge)
+	{
+		kind |= EDGE_KIND_BACK_EDGE;
+	}
+
+	switch(edge_properties.GetEdgeKind().as_enum())
+	{
+		case CFGEdgeKind::impossible:
+			kind |= EDGE_KIND_IMPOSSIBLE;
+			break;
+		case CFGEdgeKind::function_call:
+			kind |= EDGE_KIND_FUNCTION_CALL;
+			break;
+		case CFGEdgeKind::function_return:
+			kind |= EDGE_KIND_RETURN;
+			break;
+		case CFGEdgeKind::function_call_bypass:
+			kind |= EDGE_KIND_FUNCTION_CALL_BYPASS;
+			break;
+		default:
+			break;
+	}
+
+	return kind;
+}
+
+void ControlFlowGraphSnapshot::ComputeFilteredDegrees()
+{
+	std::size_t num_vertices = m_statements.size();
+
+	m_filtered_in_degrees.assign(num_vertices, 0);
+	m_filtered_out_degrees.assign(num_vertices, 0);
+
+	for(vertex_descriptor v = 0; v < num_vertices; ++v)
+	{
+		bool saw_function_call_already = false;
+		for(std::size_t i = m_in_offsets[v]; i < m_in_offsets[v+1]; ++i)
+		{
+			T_EDGE_KIND kind = m_in_edge_kinds[i];
+
+			if(kind & EDGE_KIND_BACK_EDGE)
+			{
+				// Always skip anything marked as a back edge.
+				continue;
+			}
+
+			// Count up all the incoming edges, with two exceptions:
+			// - Ignore Return edges.  They will always have exactly one matching FunctionCallBypass, which
+			//   is what we'll count instead.
+			// - Ignore all but the first FunctionCall edge.  v is then an ENTRY statement, and any particular
+			//   instance of it has at most one valid FunctionCall edge, which is all we care about here.
+			if(!(kind & EDGE_KIND_RETURN) && (saw_function_call_already == false))
+			{
+				++m_filtered_in_degrees[v];
+			}
+
+			if(kind & EDGE_KIND_FUNCTION_CALL)
+			{
+				// Multiple incoming function calls only count as one for convergence purposes.
+				saw_function_call_already = true;
+			}
+		}
+
+		for(std::size_t i = m_out_offsets[v]; i < m_out_offsets[v+1]; ++i)
+		{
+			if(!(m_out_edge_kinds[i] & EDGE_KIND_BACK_EDGE))
+			{
+				++m_filtered_out_degrees[v];
+			}
+		}
+	}
+}
@@ -0,0 +1,303 @@
+/*
+ * Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+ *
+ * This file is part of CoFlo.
+ *
+ * CoFlo is free software: you can redistribute it and/or modify it under the
+ * terms of version 3 of the GNU General Public License as published by the Free
+ * Software Foundation.
+ *
+ * CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file */
+
+#ifndef CONTROLFLOWGRAPHSNAPSHOT_H
+#define CONTROLFLOWGRAPHSNAPSHOT_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <boost/utility.hpp>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+
+#include "ControlFlowGraph.h"
+
+class FunctionCallResolved;
+
+/**
+ * An immutable, compressed-sparse-row copy of a T_CFG.
+ *
+ * The out edges and the in edges of every vertex are stored contiguously in two flat arrays, indexed by
+ * per-vertex offsets, so walking the whole-program graph touches a few large arrays instead of chasing
+ * one std::list node per edge.  The kind of each edge (back edge, function call, return, etc.) is
+ * classified once, when the snapshot is built, and stored in a parallel byte array.  This lets
+ * traversals decide whether to follow an edge without touching the T_CFG's edge properties at all.
+ * The filtered in and out degrees which topological_visit_kahn() and the CFG printer need are
+ * likewise computed once for every vertex.
+ *
+ * Vertex descriptors are the same as the T_CFG's, and the edges are the T_CFG's own edge descriptors,
+ * so visitors written against T_CFG keep working unchanged on a snapshot.  Edges are stored in the same
+ * order T_CFG iterates them.
+ *
+ * A snapshot can also be a slice of another snapshot, containing only the vertices some analysis cares
+ * about.  See the slicing constructor.
+ *
+ * The snapshot models the Boost Graph Library's BidirectionalGraph and VertexListGraph concepts.
+ */
+class ControlFlowGraphSnapshot : boost::noncopyable
+{
+public:
+
+	/// @name Boost Graph Library graph_traits<> types.
+	//@{
+	typedef T_CFG_VERTEX_DESC vertex_descriptor;
+	typedef T_CFG_EDGE_DESC edge_descriptor;
+	typedef const T_CFG_EDGE_DESC* out_edge_iterator;
+	typedef const T_CFG_EDGE_DESC* in_edge_iterator;
+	typedef boost::counting_iterator<T_CFG_VERTEX_DESC> vertex_iterator;
+	typedef boost::bidirectional_tag directed_category;
+	typedef boost::allow_parallel_edge_tag edge_parallel_category;
+	struct traversal_category : public virtual boost::bidirectional_graph_tag, public virtual boost::vertex_list_graph_tag
+	{
+	};
+	typedef std::size_t vertices_size_type;
+	typedef std::size_t edges_size_type;
+	typedef std::size_t degree_size_type;
+
+	static vertex_descriptor null_vertex() { return boost::graph_traits<T_CFG>::null_vertex(); };
+	//@}
+
+	/// Flags describing what kind of edge an edge is.  Several may be set at once.
+	enum EdgeKindFlags
+	{
+		/// The edge has been marked as a back edge.
+		EDGE_KIND_BACK_EDGE = 0x01,
+		/// The edge can never be taken.
+		EDGE_KIND_IMPOSSIBLE = 0x02,
+		/// The edge is a CFGEdgeKind::function_call.
+		EDGE_KIND_FUNCTION_CALL = 0x04,
+		/// The edge is a CFGEdgeKind::function_return.
+		EDGE_KIND_RETURN = 0x08,
+		/// The edge is a CFGEdgeKind::function_call_bypass.
+		EDGE_KIND_FUNCTION_CALL_BYPASS = 0x10
+	};
+
+	/// Type of the packed edge kind stored for each edge.  A bitwise OR of EdgeKindFlags.
+	typedef unsigned char T_EDGE_KIND;
+
+	/**
+	 * Build a snapshot of @a cfg.
+	 *
+	 * @param cfg The graph to copy.  The snapshot holds no reference to it once constructed, but the edge
+	 *        descriptors it hands out still refer to @a cfg's edge properties.
+	 */
+	explicit ControlFlowGraphSnapshot(const ControlFlowGraph &cfg);
+
+	/**
+	 * Build a slice of @a graph, which drops the vertices an analysis doesn't need to see.
+	 *
+	 * A vertex is kept if @a is_relevant accepts its statement, or if it can't be bypassed: it has more than
+	 * one out edge, or its out edge is anything but a plain edge (back edge, impossible, call, return, bypass).
+	 * Every other vertex is spliced out: each out edge of a kept vertex is followed through any spliced-out
+	 * vertices to the next kept vertex, and becomes a single edge to it.  Since only plain edges are spliced
+	 * through, the new edge has exactly the kind and back edge flag of the original edge it starts with.
+	 *
+	 * Vertex descriptors are unchanged, so statements, locations and the results of visitor predicates
+	 * map straight back to the original graph; spliced-out vertices are simply left with no edges.  Each new
+	 * edge is an edge descriptor with the slice's source and target, sharing the edge properties of the
+	 * original edge it starts with.  It therefore compares equal to that edge, and ControlFlowGraph's edge
+	 * accessors, such as GetEdgeType() and GetEdgeFunctionCall(), describe it correctly.
+	 *
+	 * @param graph The snapshot to slice.  The slice holds no reference to it.
+	 * @param is_relevant Predicate selecting the statements which must be kept.
+	 */
+	ControlFlowGraphSnapshot(const ControlFlowGraphSnapshot &graph, T_SLICE_PREDICATE is_relevant);
+	~ControlFlowGraphSnapshot();
+
+	/// @name Adjacency accessors.
+	//@{
+	std::pair<out_edge_iterator, out_edge_iterator> OutEdges(vertex_descriptor v) const
+	{
+		return EdgeRange(m_out_edges, m_out_offsets, v);
+	};
+
+	std::pair<in_edge_iterator, in_edge_iterator> InEdges(vertex_descriptor v) const
+	{
+		return EdgeRange(m_in_edges, m_in_offsets, v);
+	};
+
+	degree_size_type OutDegree(vertex_descriptor v) const { return m_out_offsets[v+1] - m_out_offsets[v]; };
+	degree_size_type InDegree(vertex_descriptor v) const { return m_in_offsets[v+1] - m_in_offsets[v]; };
+
+	/**
+	 * The in degree of @a v as topological_visit_kahn() needs to see it.
+	 *
+	 * Back edges and Return edges aren't counted, and any number of incoming FunctionCall edges only count
+	 * as one.
+	 */
+	long FilteredInDegree(vertex_descriptor v) const { return m_filtered_in_degrees[v]; };
+
+	/// The out degree of @a v, not counting back edges.
+	long FilteredOutDegree(vertex_descriptor v) const { return m_filtered_out_degrees[v]; };
+
+	vertices_size_type GetNumberOfVertices() const { return m_statements.size(); };
+	edges_size_type GetNumberOfEdges() const { return m_out_edges.size(); };
+	//@}
+
+	/// @name Vertex and edge attribute accessors.
+	//@{
+	StatementBase* GetStatementPtr(vertex_descriptor v) const { return m_statements[v]; };
+
+	/**
+	 * Return the packed kind of the out edge at @a ei.
+	 *
+	 * @param ei An iterator obtained from OutEdges().
+	 * @return A bitwise OR of EdgeKindFlags.
+	 */
+	T_EDGE_KIND GetOutEdgeKind(out_edge_iterator ei) const { return m_out_edge_kinds[ei - &m_out_edges[0]]; };
+
+	/**
+	 * Return the FunctionCallResolved a call or return out edge belongs to.
+	 *
+	 * @param ei An iterator obtained from OutEdges().
+	 * @return The call which the edge was created for, or NULL if the edge is neither a call nor a return.
+	 */
+	FunctionCallResolved* GetOutEdgeFunctionCall(out_edge_iterator ei) const { return m_out_edge_function_calls[ei - &m_out_edges[0]]; };
+
+	/**
+	 * Return the packed kind of the in edge at @a ei.
+	 *
+	 * @param ei An iterator obtained from InEdges().
+	 * @return A bitwise OR of EdgeKindFlags.
+	 */
+	T_EDGE_KIND GetInEdgeKind(in_edge_iterator ei) const { return m_in_edge_kinds[ei - &m_in_edges[0]]; };
+	//@}
+
+private:
+
+	static std::pair<const T_CFG_EDGE_DESC*, const T_CFG_EDGE_DESC*> EdgeRange(const std::vector<T_CFG_EDGE_DESC> &edges,
+			const std::vector<std::size_t> &offsets, vertex_descriptor v)
+	{
+		if(edges.empty())
+		{
+			// Nothing to point into.
+			return std::make_pair(static_cast<const T_CFG_EDGE_DESC*>(NULL), static_cast<const T_CFG_EDGE_DESC*>(NULL));
+		}
+		return std::make_pair(&edges[0] + offsets[v], &edges[0] + offsets[v+1]);
+	};
+
+	/**
+	 * Work out the packed kind of an edge from its properties.
+	 *
+	 * @param edge_properties The edge's properties in the T_CFG.
+	 * @return The edge's EdgeKindFlags.
+	 */
+	static T_EDGE_KIND ClassifyEdge(const CFGEdgeProperties &edge_properties);
+
+	/// Fill in m_filtered_in_degrees and m_filtered_out_degrees from the finished adjacency arrays.
+	void ComputeFilteredDegrees();
+
+	/// The Statement at each vertex, indexed by vertex descriptor.
+	std::vector<StatementBase*> m_statements;
+
+	/// @name Forward adjacency.
+	/// The out edges of vertex v are m_out_edges[m_out_offsets[v]] up to but not including m_out_edges[m_out_offsets[v+1]].
+	//@{
+	std::vector<std::size_t> m_out_offsets;
+	std::vector<T_CFG_EDGE_DESC> m_out_edges;
+	std::vector<T_EDGE_KIND> m_out_edge_kinds;
+	std::vector<FunctionCallResolved*> m_out_edge_function_calls;
+	//@}
+
+	/// @name Reverse adjacency.
+	//@{
+	std::vector<std::size_t> m_in_offsets;
+	std::vector<T_CFG_EDGE_DESC> m_in_edges;
+	std::vector<T_EDGE_KIND> m_in_edge_kinds;
+	//@}
+
+	/// @name Filtered degrees, indexed by vertex descriptor.
+	//@{
+	std::vector<long> m_filtered_in_degrees;
+	std::vector<long> m_filtered_out_degrees;
+	//@}
+};
+
+/// @name Boost Graph Library interface to ControlFlowGraphSnapshot.
+/// These are found by argument-dependent lookup, so generic algorithms must call them unqualified.
+//@{
+
+inline std::pair<ControlFlowGraphSnapshot::out_edge_iterator, ControlFlowGraphSnapshot::out_edge_iterator>
+out_edges(T_CFG_VERTEX_DESC v, const ControlFlowGraphSnapshot &g)
+{
+	return g.OutEdges(v);
+}
+
+inline std::pair<ControlFlowGraphSnapshot::in_edge_iterator, ControlFlowGraphSnapshot::in_edge_iterator>
+in_edges(T_CFG_VERTEX_DESC v, const ControlFlowGraphSnapshot &g)
+{
+	return g.InEdges(v);
+}
+
+inline T_CFG_VERTEX_DESC source(const T_CFG_EDGE_DESC &e, const ControlFlowGraphSnapshot &)
+{
+	return e.m_source;
+}
+
+inline T_CFG_VERTEX_DESC target(const T_CFG_EDGE_DESC &e, const ControlFlowGraphSnapshot &)
+{
+	return e.m_target;
+}
+
+inline ControlFlowGraphSnapshot::degree_size_type out_degree(T_CFG_VERTEX_DESC v, const ControlFlowGraphSnapshot &g)
+{
+	return g.OutDegree(v);
+}
+
+inline ControlFlowGraphSnapshot::degree_size_type in_degree(T_CFG_VERTEX_DESC v, const ControlFlowGraphSnapshot &g)
+{
+	return g.InDegree(v);
+}
+
+inline ControlFlowGraphSnapshot::degree_size_type degree(T_CFG_VERTEX_DESC v, const ControlFlowGraphSnapshot &g)
+{
+	return g.InDegree(v) + g.OutDegree(v);
+}
+
+inline std::pair<ControlFlowGraphSnapshot::vertex_iterator, ControlFlowGraphSnapshot::vertex_iterator>
+vertices(const ControlFlowGraphSnapshot &g)
+{
+	return std::make_pair(ControlFlowGraphSnapshot::vertex_iterator(0),
+			ControlFlowGraphSnapshot::vertex_iterator(g.GetNumberOfVertices()));
+}
+
+inline ControlFlowGraphSnapshot::vertices_size_type num_vertices(const ControlFlowGraphSnapshot &g)
+{
+	return g.GetNumberOfVertices();
+}
+
+//@}
+
+/// @name Filtered degrees of a ControlFlowGraphSnapshot.
+/// See ControlFlowGraphSnapshot::FilteredInDegree() and ControlFlowGraphSnapshot::FilteredOutDegree().
+//@{
+inline long filtered_in_degree(T_CFG_VERTEX_DESC v, const ControlFlowGraphSnapshot &g)
+{
+	return g.FilteredInDegree(v);
+}
+
+inline long filtered_out_degree(T_CFG_VERTEX_DESC v, const ControlFlowGraphSnapshot &g)
+{
+	return g.FilteredOutDegree(v);
+}
+//@}
+
+#endif /* CONTROLFLOWGRAPHSNAPSHOT_H */
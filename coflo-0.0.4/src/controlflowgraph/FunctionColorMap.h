@@ -0,0 +1,123 @@
+/*
+ * Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+ *
+ * This file is part of CoFlo.
+ *
+ * CoFlo is free software: you can redistribute it and/or modify it under the
+ * terms of version 3 of the GNU General Public License as published by the Free
+ * Software Foundation.
+ *
+ * CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file */
+
+#ifndef FUNCTIONCOLORMAP_H
+#define FUNCTIONCOLORMAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <boost/graph/properties.hpp>
+#include <boost/unordered_map.hpp>
+
+#include "ControlFlowGraph.h"
+
+/**
+ * The colors of the vertices a traversal has reached in one call of a Function.
+ *
+ * Each vertex of the Function gets a slot in a dense array, indexed by its position in the Function's
+ * FunctionVertexRange.  Each slot carries the epoch it was last written in, and a slot from any other epoch
+ * reads as white, so Reset() starts the map over without touching the array.  The arrays only ever grow,
+ * so a map which is reset over and over for different calls stops allocating once it's seen the largest
+ * Function.  The rare vertex of some other Function, which a traversal can reach by following a return
+ * edge, goes in a small hash map instead.
+ */
+class FunctionColorMap
+{
+	typedef boost::color_traits<boost::default_color_type> T_COLOR;
+
+public:
+	FunctionColorMap() : m_range(NULL), m_epoch(0) {};
+
+	/**
+	 * Make every vertex white again, and index the map by the vertices of @a range from now on.
+	 *
+	 * @param range The vertices of the Function being called.
+	 */
+	void Reset(const FunctionVertexRange *range)
+	{
+		m_range = range;
+		if(m_stamps.size() < range->Size())
+		{
+			m_stamps.resize(range->Size(), 0);
+			m_colors.resize(range->Size());
+		}
+
+		++m_epoch;
+		if(m_epoch == 0)
+		{
+			// The epoch wrapped around, so a stale stamp could match it.  Wipe them all.
+			std::fill(m_stamps.begin(), m_stamps.end(), 0);
+			m_epoch = 1;
+		}
+
+		if(!m_other_vertices.empty())
+		{
+			m_other_vertices.clear();
+		}
+	};
+
+	boost::default_color_type get(T_CFG_VERTEX_DESC v) const
+	{
+		std::size_t i = m_range->LocalIndex(v);
+		if(i < m_range->Size())
+		{
+			return (m_stamps[i] == m_epoch) ? m_colors[i] : T_COLOR::white();
+		}
+
+		T_OTHER_VERTEX_MAP::const_iterator it = m_other_vertices.find(v);
+		return (it == m_other_vertices.end()) ? T_COLOR::white() : it->second;
+	};
+
+	void set(T_CFG_VERTEX_DESC v, boost::default_color_type color)
+	{
+		std::size_t i = m_range->LocalIndex(v);
+		if(i < m_range->Size())
+		{
+			m_stamps[i] = m_epoch;
+			m_colors[i] = color;
+		}
+		else
+		{
+			m_other_vertices[v] = color;
+		}
+	};
+
+private:
+
+	typedef boost::unordered_map<T_CFG_VERTEX_DESC, boost::default_color_type> T_OTHER_VERTEX_MAP;
+
+	/// The vertices the dense arrays are indexed by.
+	const FunctionVertexRange *m_range;
+
+	/// The current epoch.  Slots stamped with anything else are white.
+	unsigned int m_epoch;
+
+	/// The epoch each slot was last set in.
+	std::vector<unsigned int> m_stamps;
+
+	/// The color of each slot, valid only if its stamp is the current epoch.
+	std::vector<boost::default_color_type> m_colors;
+
+	/// The colors of vertices which aren't in m_range.
+	T_OTHER_VERTEX_MAP m_other_vertices;
+};
+
+#endif /* FUNCTIONCOLORMAP_H */
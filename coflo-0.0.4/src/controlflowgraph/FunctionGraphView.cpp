@@ -0,0 +1,92 @@
+/*
+ * Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+ *
+ * This file is part of CoFlo.
+ *
+ * CoFlo is free software: you can redistribute it and/or modify it under the
+ * terms of version 3 of the GNU General Public License as published by the Free
+ * Software Foundation.
+ *
+ * CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file */
+
+#include "FunctionGraphView.h"
+
+FunctionGraphView::FunctionGraphView(const ControlFlowGraph &cfg, Function *f)
+	: m_cfg(cfg.GetConstT_CFG()), m_function(f), m_range(cfg.GetFunctionVertexRange(f)), m_edges_valid(false)
+{
+}
+
+std::pair<FunctionGraphView::out_edge_iterator, FunctionGraphView::out_edge_iterator>
+FunctionGraphView::OutEdges(vertex_descriptor v) const
+{
+	T_CFG_OUT_EDGE_ITERATOR ei, eend;
+	target_in_function pred(&m_cfg, m_function);
+
+	boost::tie(ei, eend) = boost::out_edges(v, m_cfg);
+	return std::make_pair(out_edge_iterator(pred, ei, eend), out_edge_iterator(pred, eend, eend));
+}
+
+std::pair<FunctionGraphView::in_edge_iterator, FunctionGraphView::in_edge_iterator>
+FunctionGraphView::InEdges(vertex_descriptor v) const
+{
+	T_CFG_IN_EDGE_ITERATOR ei, eend;
+	source_in_function pred(&m_cfg, m_function);
+
+	boost::tie(ei, eend) = boost::in_edges(v, m_cfg);
+	return std::make_pair(in_edge_iterator(pred, ei, eend), in_edge_iterator(pred, eend, eend));
+}
+
+FunctionGraphView::degree_size_type FunctionGraphView::OutDegree(vertex_descriptor v) const
+{
+	out_edge_iterator ei, eend;
+	degree_size_type retval = 0;
+
+	for(boost::tie(ei, eend) = OutEdges(v); ei != eend; ++ei)
+	{
+		++retval;
+	}
+
+	return retval;
+}
+
+FunctionGraphView::degree_size_type FunctionGraphView::InDegree(vertex_descriptor v) const
+{
+	in_edge_iterator ei, eend;
+	degree_size_type retval = 0;
+
+	for(boost::tie(ei, eend) = InEdges(v); ei != eend; ++ei)
+	{
+		++retval;
+	}
+
+	return retval;
+}
+
+std::pair<FunctionGraphView::edge_iterator, FunctionGraphView::edge_iterator> FunctionGraphView::Edges() const
+{
+	if(!m_edges_valid)
+	{
+		vertex_iterator vit, vend;
+		out_edge_iterator ei, eend;
+
+		// Walk the function's vertices rather than the whole-program edge list.
+		for(boost::tie(vit, vend) = Vertices(); vit != vend; ++vit)
+		{
+			for(boost::tie(ei, eend) = OutEdges(*vit); ei != eend; ++ei)
+			{
+				m_edges.push_back(*ei);
+			}
+		}
+		m_edges_valid = true;
+	}
+
+	return std::make_pair(m_edges.begin(), m_edges.end());
+}
@@ -0,0 +1,280 @@
+/*
+ * Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+ *
+ * This file is part of CoFlo.
+ *
+ * CoFlo is free software: you can redistribute it and/or modify it under the
+ * terms of version 3 of the GNU General Public License as published by the Free
+ * Software Foundation.
+ *
+ * CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file */
+
+#ifndef FUNCTIONGRAPHVIEW_H
+#define FUNCTIONGRAPHVIEW_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <boost/utility.hpp>
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp>
+#include <boost/property_map/property_map.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/filter_iterator.hpp>
+#include <boost/iterator/transform_iterator.hpp>
+
+#include "ControlFlowGraph.h"
+
+/**
+ * A view of the part of a T_CFG which belongs to a single Function.
+ *
+ * This replaces the boost::filtered_graph<> views we used to build over the whole-program T_CFG.  Those
+ * had to look at every vertex in the program to enumerate the vertices of one function, which made setting
+ * up every function's CFG quadratic in the size of the program.  This view instead enumerates the vertices
+ * recorded in the Function's FunctionVertexRange, so every per-function pass costs time proportional to the
+ * size of that function.
+ *
+ * The view sees exactly what the old filtered_graph<> did: vertices of the function, out edges whose targets
+ * are in the function, and in edges whose sources are in the function.  Descriptors are the T_CFG's own.
+ * The vertex_index property map gives each vertex its position in the FunctionVertexRange, so the Boost
+ * Graph Library algorithms' default color maps are sized to the function, not the program.
+ *
+ * The view holds references to the T_CFG and the FunctionVertexRange.  Adding edges to the underlying graph
+ * while holding a view is fine; adding vertices to the function while iterating over the view's vertices
+ * is not.
+ *
+ * Models the Boost Graph Library's BidirectionalGraph, VertexListGraph and EdgeListGraph concepts.
+ */
+class FunctionGraphView : boost::noncopyable
+{
+	/// Edge predicate which only passes edges whose target is in the function.
+	struct target_in_function
+	{
+		target_in_function() : m_cfg(NULL), m_function(NULL) {};
+		target_in_function(const T_CFG *cfg, Function *f) : m_cfg(cfg), m_function(f) {};
+		bool operator()(const T_CFG_EDGE_DESC &e) const { return (*m_cfg)[boost::target(e, *m_cfg)].m_containing_function == m_function; };
+
+		const T_CFG *m_cfg;
+		Function *m_function;
+	};
+
+	/// Edge predicate which only passes edges whose source is in the function.
+	struct source_in_function
+	{
+		source_in_function() : m_cfg(NULL), m_function(NULL) {};
+		source_in_function(const T_CFG *cfg, Function *f) : m_cfg(cfg), m_function(f) {};
+		bool operator()(const T_CFG_EDGE_DESC &e) const { return (*m_cfg)[boost::source(e, *m_cfg)].m_containing_function == m_function; };
+
+		const T_CFG *m_cfg;
+		Function *m_function;
+	};
+
+	/// Maps a position in the FunctionVertexRange to the vertex there.
+	struct local_index_to_vertex
+	{
+		typedef T_CFG_VERTEX_DESC result_type;
+
+		local_index_to_vertex() : m_range(NULL) {};
+		explicit local_index_to_vertex(const FunctionVertexRange *range) : m_range(range) {};
+		T_CFG_VERTEX_DESC operator()(std::size_t i) const { return (*m_range)[i]; };
+
+		const FunctionVertexRange *m_range;
+	};
+
+public:
+
+	/// @name Boost Graph Library graph_traits<> types.
+	//@{
+	typedef T_CFG_VERTEX_DESC vertex_descriptor;
+	typedef T_CFG_EDGE_DESC edge_descriptor;
+	typedef boost::filter_iterator<target_in_function, T_CFG_OUT_EDGE_ITERATOR> out_edge_iterator;
+	typedef boost::filter_iterator<source_in_function, T_CFG_IN_EDGE_ITERATOR> in_edge_iterator;
+	typedef boost::transform_iterator<local_index_to_vertex, boost::counting_iterator<std::size_t> > vertex_iterator;
+	typedef std::vector<T_CFG_EDGE_DESC>::const_iterator edge_iterator;
+	typedef void adjacency_iterator;
+	typedef boost::bidirectional_tag directed_category;
+	typedef boost::allow_parallel_edge_tag edge_parallel_category;
+	struct traversal_category : public virtual boost::bidirectional_graph_tag, public virtual boost::vertex_list_graph_tag,
+		public virtual boost::edge_list_graph_tag
+	{
+	};
+	typedef std::size_t vertices_size_type;
+	typedef std::size_t edges_size_type;
+	typedef std::size_t degree_size_type;
+
+	static vertex_descriptor null_vertex() { return boost::graph_traits<T_CFG>::null_vertex(); };
+	//@}
+
+	/**
+	 * Readable property map from a vertex of the view to its position in the function's FunctionVertexRange.
+	 * This is what get(boost::vertex_index, view) returns.
+	 */
+	class vertex_index_map
+	{
+	public:
+		typedef T_CFG_VERTEX_DESC key_type;
+		typedef std::size_t value_type;
+		typedef std::size_t reference;
+		typedef boost::readable_property_map_tag category;
+
+		vertex_index_map() : m_range(NULL) {};
+		explicit vertex_index_map(const FunctionVertexRange *range) : m_range(range) {};
+
+		std::size_t operator[](T_CFG_VERTEX_DESC v) const { return m_range->LocalIndex(v); };
+
+	private:
+		const FunctionVertexRange *m_range;
+	};
+
+	/**
+	 * Constructor.
+	 *
+	 * @param cfg The control flow graph containing @a f.
+	 * @param f The Function whose part of @a cfg to view.
+	 */
+	FunctionGraphView(const ControlFlowGraph &cfg, Function *f);
+
+	/// @name Adjacency accessors.
+	//@{
+	std::pair<out_edge_iterator, out_edge_iterator> OutEdges(vertex_descriptor v) const;
+	std::pair<in_edge_iterator, in_edge_iterator> InEdges(vertex_descriptor v) const;
+	degree_size_type OutDegree(vertex_descriptor v) const;
+	degree_size_type InDegree(vertex_descriptor v) const;
+
+	std::pair<vertex_iterator, vertex_iterator> Vertices() const
+	{
+		local_index_to_vertex xform(&m_range);
+		return std::make_pair(vertex_iterator(boost::counting_iterator<std::size_t>(0), xform),
+				vertex_iterator(boost::counting_iterator<std::size_t>(m_range.Size()), xform));
+	};
+
+	/**
+	 * Return the edges of the view, vertex by vertex, each vertex's out edges in T_CFG order.  Unlike
+	 * filtered_graph<>, this doesn't follow the whole-program edge list, so the order can differ from it.
+	 * The list is built on the first call and cached, so it doesn't reflect edges added afterwards.
+	 */
+	std::pair<edge_iterator, edge_iterator> Edges() const;
+
+	vertices_size_type GetNumberOfVertices() const { return m_range.Size(); };
+	edges_size_type GetNumberOfEdges() const { return Edges().second - Edges().first; };
+
+	vertex_index_map GetVertexIndexMap() const { return vertex_index_map(&m_range); };
+	//@}
+
+	/// @name Bundled property access, as for T_CFG.
+	//@{
+	const CFGVertexProperties& operator[](vertex_descriptor v) const { return m_cfg[v]; };
+	const CFGEdgeProperties& operator[](const edge_descriptor &e) const { return m_cfg[e]; };
+	//@}
+
+private:
+
+	/// The whole-program graph we're a view of.
+	const T_CFG &m_cfg;
+
+	/// The function whose vertices we see.
+	Function *m_function;
+
+	/// The function's vertices.
+	const FunctionVertexRange &m_range;
+
+	/// Cache of the view's edges, filled in by the first call to Edges().
+	mutable std::vector<T_CFG_EDGE_DESC> m_edges;
+	mutable bool m_edges_valid;
+};
+
+/// @name Boost Graph Library interface to FunctionGraphView.
+/// Found by argument-dependent lookup, so generic code must call these unqualified.
+//@{
+
+inline std::pair<FunctionGraphView::out_edge_iterator, FunctionGraphView::out_edge_iterator>
+out_edges(T_CFG_VERTEX_DESC v, const FunctionGraphView &g)
+{
+	return g.OutEdges(v);
+}
+
+inline std::pair<FunctionGraphView::in_edge_iterator, FunctionGraphView::in_edge_iterator>
+in_edges(T_CFG_VERTEX_DESC v, const FunctionGraphView &g)
+{
+	return g.InEdges(v);
+}
+
+inline T_CFG_VERTEX_DESC source(const T_CFG_EDGE_DESC &e, const FunctionGraphView &)
+{
+	return e.m_source;
+}
+
+inline T_CFG_VERTEX_DESC target(const T_CFG_EDGE_DESC &e, const FunctionGraphView &)
+{
+	return e.m_target;
+}
+
+inline FunctionGraphView::degree_size_type out_degree(T_CFG_VERTEX_DESC v, const FunctionGraphView &g)
+{
+	return g.OutDegree(v);
+}
+
+inline FunctionGraphView::degree_size_type in_degree(T_CFG_VERTEX_DESC v, const FunctionGraphView &g)
+{
+	return g.InDegree(v);
+}
+
+inline FunctionGraphView::degree_size_type degree(T_CFG_VERTEX_DESC v, const FunctionGraphView &g)
+{
+	return g.InDegree(v) + g.OutDegree(v);
+}
+
+inline std::pair<FunctionGraphView::vertex_iterator, FunctionGraphView::vertex_iterator>
+vertices(const FunctionGraphView &g)
+{
+	return g.Vertices();
+}
+
+inline FunctionGraphView::vertices_size_type num_vertices(const FunctionGraphView &g)
+{
+	return g.GetNumberOfVertices();
+}
+
+inline std::pair<FunctionGraphView::edge_iterator, FunctionGraphView::edge_iterator>
+edges(const FunctionGraphView &g)
+{
+	return g.Edges();
+}
+
+inline FunctionGraphView::edges_size_type num_edges(const FunctionGraphView &g)
+{
+	return g.GetNumberOfEdges();
+}
+
+inline FunctionGraphView::vertex_index_map get(boost::vertex_index_t, const FunctionGraphView &g)
+{
+	return g.GetVertexIndexMap();
+}
+
+inline std::size_t get(const FunctionGraphView::vertex_index_map &pmap, T_CFG_VERTEX_DESC v)
+{
+	return pmap[v];
+}
+
+//@}
+
+namespace boost
+{
+	template <>
+	struct property_map<FunctionGraphView, vertex_index_t>
+	{
+		typedef FunctionGraphView::vertex_index_map type;
+		typedef FunctionGraphView::vertex_index_map const_type;
+	};
+}
+
+#endif /* FUNCTIONGRAPHVIEW_H */
@@ -19,23 +19,55 @@
 
 #include "Analyzer.h"
 
+#include <iostream>
+
 #include <boost/foreach.hpp>
 #include <boost/regex.hpp>
 
 #include "RuleBase.h"
 #include "RuleReachability.h"
+#include "CallGraphReachabilityIndex.h"
+#include "ReachabilitySummaries.h"
 
 #include "Program.h"
 #include "Function.h"
+#include "parallel_for.hpp"
 
 /// Regex for function-calls-function constraint "f1() -x f2()".
 static const boost::regex f_fxf_regex("([[:alpha:]_][[:alnum:]_]+)\\(\\) -x ([[:alpha:]_][[:alnum:]_]+)\\(\\)");
 
-Analyzer::Analyzer() { }
+/**
+ * parallel_for() body which checks one rule.
+ */
+class RunRuleBody
+{
+public:
+	RunRuleBody(const std::vector< RuleBase* > &rules) : m_rules(rules) {};
+
+	void operator()(long i)
+	{
+		m_rules[i]->RunRule();
+	};
+
+private:
+	const std::vector< RuleBase* > &m_rules;
+};
+
+Analyzer::Analyzer() : m_program(NULL), m_num_jobs(1), m_call_graph_index(NULL), m_reachability_summaries(NULL) { }
 
-Analyzer::Analyzer(const Analyzer& orig) { }
+Analyzer::Analyzer(const Analyzer& orig) : m_program(orig.m_program), m_num_jobs(orig.m_num_jobs), m_call_graph_index(NULL),
+		m_reachability_summaries(NULL) { }
 
-Analyzer::~Analyzer() { }
+Analyzer::~Analyzer()
+{
+	BOOST_FOREACH(RuleBase *rule, m_rules)
+	{
+		delete rule;
+	}
+
+	delete m_reachability_summaries;
+	delete m_call_graph_index;
+}
 
 void Analyzer::AddConstraints(const std::vector< std::string > &vector_of_constraint_strings)
 {
@@ -66,8 +98,24 @@ void Analyzer::AddConstraints(const std::vector< std::string > &vector_of_constr
 				std::cerr << "INFO: Adding constraint: "
 						<< f1->GetIdentifier() << "() -x "
 						<< f2->GetIdentifier() << "()" << std::endl;
-				RuleReachability *rule = new RuleReachability(*m_program->GetControlFlowGraphPtr(), f1, f2);
-				m_constraints.push_back(rule);
+				if(m_reachability_summaries == NULL)
+				{
+					m_call_graph_index = new CallGraphReachabilityIndex(*m_program->GetControlFlowGraphPtr());
+					m_reachability_summaries = new ReachabilitySummaries(*m_program->GetControlFlowGraphPtr(), *m_call_graph_index);
+					std::cerr << "INFO: Call graph has " << m_call_graph_index->GetNumberOfFunctions()
+							<< " functions in " << m_call_graph_index->GetNumberOfComponents()
+							<< " strongly connected components." << std::endl;
+				}
+
+				// All the constraints on one source are checked by one rule, so it only has to search once.
+				RuleReachability *&rule = m_reachability_rules[f1];
+				if(rule == NULL)
+				{
+					rule = new RuleReachability(*m_program->GetControlFlowGraphPtr(),
+							m_call_graph_index, m_reachability_summaries, f1);
+					m_rules.push_back(rule);
+				}
+				m_constraints.push_back(std::make_pair(rule, rule->AddSink(f2)));
 			}
 		}
 		else
@@ -79,10 +127,25 @@ void Analyzer::AddConstraints(const std::vector< std::string > &vector_of_constr
 
 bool Analyzer::Analyze()
 {
-	// Run all analyses.
-	BOOST_FOREACH(RuleBase *constraint, m_constraints)
+	// The reachability summaries are computed on demand, which isn't thread-safe.  Compute everything the
+	// rules can ask for up front, so while they run, all the state they share is read-only.
+	if(m_reachability_summaries != NULL)
+	{
+		std::map< const Function*, RuleReachability* >::const_iterator it;
+		for(it = m_reachability_rules.begin(); it != m_reachability_rules.end(); ++it)
+		{
+			m_reachability_summaries->Precompute(it->first);
+		}
+	}
+
+	// Run all analyses.  Each rule buffers its own reports.
+	parallel_for(m_num_jobs, m_rules.size(), RunRuleBody(m_rules));
+
+	// Print the reports in constraint order, however the rules grouped the constraints and were scheduled.
+	std::vector< std::pair<RuleBase*, std::size_t> >::const_iterator it;
+	for(it = m_constraints.begin(); it != m_constraints.end(); ++it)
 	{
-		constraint->RunRule();
+		std::cout << it->first->GetReport(it->second);
 	}
 
 	/// @todo Make this real.
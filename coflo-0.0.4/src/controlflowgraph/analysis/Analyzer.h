@@ -20,13 +20,19 @@
 #ifndef ANALYZER_H
 #define	ANALYZER_H
 
+#include <map>
 #include <vector>
 #include <string>
+#include <utility>
 
 #include "../ControlFlowGraph.h"
 
 class Program;
 class RuleBase;
+class RuleReachability;
+class Function;
+class CallGraphReachabilityIndex;
+class ReachabilitySummaries;
 
 class Analyzer
 {
@@ -39,16 +45,47 @@ public:
 	void AddConstraints(const std::vector< std::string > &vector_of_constraint_strings);
 	
 	void AttachToProgram(Program *p) { m_program = p; };
+
+	/**
+	 * Set the number of threads Analyze() may check constraints on.
+	 *
+	 * @param num_jobs Number of worker threads to use.  1 (the default) checks them serially.
+	 */
+	void SetNumberOfJobs(long num_jobs) { m_num_jobs = num_jobs; };
 	
+	/**
+	 * Check all the constraints, and print the results to std::cout.
+	 *
+	 * Every constraint gets its own report, and the reports are printed in the order the constraints were
+	 * added, even though constraints with the same source are checked together, and however many threads
+	 * the rules were run on.
+	 */
 	bool Analyze();
 	
 private:
 
 	/// Pointer to the program to analyze.
 	Program *m_program;
+
+	/// The number of threads to check constraints on.
+	long m_num_jobs;
 	
-	/// The list of constraints to check m_program against.
-	std::vector< RuleBase* > m_constraints;
+	/// The rules which check m_program.  One rule may check several constraints.
+	std::vector< RuleBase* > m_rules;
+
+	/// The constraints to check m_program against, in the order they were added, as the rule which checks each
+	/// one and the number of its report in that rule.
+	std::vector< std::pair<RuleBase*, std::size_t> > m_constraints;
+
+	/// The reachability rule in m_rules for each source Function.
+	std::map< const Function*, RuleReachability* > m_reachability_rules;
+
+	/// @name Reachability analyses of m_program.
+	/// Shared by all the reachability constraints, and created along with the first one.
+	//@{
+	CallGraphReachabilityIndex *m_call_graph_index;
+	ReachabilitySummaries *m_reachability_summaries;
+	//@}
 };
 
 #endif	/* ANALYZER_H */
@@ -0,0 +1,224 @@
+/*
+ * Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+ *
+ * This file is part of CoFlo.
+ *
+ * CoFlo is free software: you can redistribute it and/or modify it under the
+ * terms of version 3 of the GNU General Public License as published by the Free
+ * Software Foundation.
+ *
+ * CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file */
+
+#include "CallGraphReachabilityIndex.h"
+
+#include <algorithm>
+#include <utility>
+
+#include <boost/foreach.hpp>
+
+#include "../ControlFlowGraph.h"
+#include "../ControlFlowGraphSnapshot.h"
+#include "../statements/FunctionCallResolved.h"
+
+CallGraphReachabilityIndex::CallGraphReachabilityIndex(ControlFlowGraph &cfg)
+{
+	const ControlFlowGraphSnapshot &graph = cfg.GetSnapshot();
+	const T_CFG &t_cfg = cfg.GetConstT_CFG();
+	ControlFlowGraphSnapshot::out_edge_iterator ei, eend;
+	std::vector< std::vector<std::size_t> > callees;
+	std::vector<const Function*> functions;
+	std::vector<bool> is_recursive;
+
+	// Number the Functions, and collect the call graph's edges from the function_call edges of the CFG.
+	for(T_CFG_VERTEX_DESC v = 0; v < graph.GetNumberOfVertices(); ++v)
+	{
+		const Function *caller = t_cfg[v].m_containing_function;
+		std::pair<boost::unordered_map<const Function*, std::size_t>::iterator, bool> caller_number;
+
+		caller_number = m_function_numbers.insert(std::make_pair(caller, m_function_numbers.size()));
+		if(caller_number.second)
+		{
+			callees.resize(m_function_numbers.size());
+			functions.push_back(caller);
+		}
+
+		// Inserting the callees below can rehash m_function_numbers, which invalidates caller_number.first.
+		std::size_t caller_index = caller_number.first->second;
+
+		for(boost::tie(ei, eend) = graph.OutEdges(v); ei != eend; ++ei)
+		{
+			if(graph.GetOutEdgeKind(ei) & ControlFlowGraphSnapshot::EDGE_KIND_FUNCTION_CALL)
+			{
+				const Function *callee = graph.GetOutEdgeFunctionCall(ei)->m_target_function;
+				std::pair<boost::unordered_map<const Function*, std::size_t>::iterator, bool> callee_number;
+
+				callee_number = m_function_numbers.insert(std::make_pair(callee, m_function_numbers.size()));
+				if(callee_number.second)
+				{
+					callees.resize(m_function_numbers.size());
+					functions.push_back(callee);
+				}
+				callees[caller_index].push_back(callee_number.first->second);
+			}
+		}
+	}
+
+	BOOST_FOREACH(std::vector<std::size_t> &function_callees, callees)
+	{
+		std::sort(function_callees.begin(), function_callees.end());
+		function_callees.erase(std::unique(function_callees.begin(), function_callees.end()), function_callees.end());
+	}
+
+	FindComponents(callees, &is_recursive);
+
+	// Every Function of a component reaches everything its members call and everything those reach.  Callees
+	// in other components always have lower numbers, so a single pass in component order sees them finished.
+	std::size_t num_components = is_recursive.size();
+	std::vector< std::vector<std::size_t> > members(num_components);
+	m_component_members.resize(num_components);
+	for(std::size_t f = 0; f < m_component_of_function.size(); ++f)
+	{
+		members[m_component_of_function[f]].push_back(f);
+		m_component_members[m_component_of_function[f]].push_back(functions[f]);
+	}
+
+	m_reachable_components.resize(num_components);
+	for(std::size_t c = 0; c < num_components; ++c)
+	{
+		boost::dynamic_bitset<> &reachable = m_reachable_components[c];
+
+		reachable.resize(num_components);
+		if(is_recursive[c])
+		{
+			// The members of a cycle of calls can all call each other, and themselves.
+			reachable.set(c);
+		}
+
+		BOOST_FOREACH(std::size_t f, members[c])
+		{
+			BOOST_FOREACH(std::size_t callee, callees[f])
+			{
+				std::size_t d = m_component_of_function[callee];
+				if(d != c)
+				{
+					reachable.set(d);
+					reachable |= m_reachable_components[d];
+				}
+			}
+		}
+	}
+}
+
+CallGraphReachabilityIndex::~CallGraphReachabilityIndex()
+{
+}
+
+bool CallGraphReachabilityIndex::MayReach(const Function *source, const Function *sink) const
+{
+	boost::unordered_map<const Function*, std::size_t>::const_iterator source_number, sink_number;
+
+	source_number = m_function_numbers.find(source);
+	sink_number = m_function_numbers.find(sink);
+	if(source_number == m_function_numbers.end() || sink_number == m_function_numbers.end())
+	{
+		// One of them isn't in the graph at all, so they certainly aren't connected.
+		return false;
+	}
+
+	return m_reachable_components[m_component_of_function[source_number->second]]
+			.test(m_component_of_function[sink_number->second]);
+}
+
+void CallGraphReachabilityIndex::FindComponents(const std::vector< std::vector<std::size_t> > &callees,
+		std::vector<bool> *is_recursive)
+{
+	// Tarjan's algorithm, with an explicit stack in place of recursion, since call chains can be deep.
+	const std::size_t num_functions = callees.size();
+	const std::size_t unvisited = num_functions;
+	std::vector<std::size_t> index(num_functions, unvisited);
+	std::vector<std::size_t> lowlink(num_functions);
+	std::vector<bool> on_stack(num_functions, false);
+	std::vector<std::size_t> component_stack;
+	std::vector< std::pair<std::size_t, std::size_t> > call_stack;
+	std::size_t next_index = 0;
+
+	m_component_of_function.assign(num_functions, 0);
+	is_recursive->clear();
+
+	for(std::size_t root = 0; root < num_functions; ++root)
+	{
+		if(index[root] != unvisited)
+		{
+			continue;
+		}
+
+		index[root] = lowlink[root] = next_index++;
+		component_stack.push_back(root);
+		on_stack[root] = true;
+		call_stack.push_back(std::make_pair(root, 0));
+
+		while(!call_stack.empty())
+		{
+			std::size_t v = call_stack.back().first;
+			std::size_t &next_callee = call_stack.back().second;
+
+			if(next_callee < callees[v].size())
+			{
+				std::size_t w = callees[v][next_callee];
+				++next_callee;
+
+				if(index[w] == unvisited)
+				{
+					index[w] = lowlink[w] = next_index++;
+					component_stack.push_back(w);
+					on_stack[w] = true;
+					call_stack.push_back(std::make_pair(w, 0));
+				}
+				else if(on_stack[w])
+				{
+					lowlink[v] = std::min(lowlink[v], index[w]);
+				}
+				continue;
+			}
+
+			// All of v's callees are done.
+			call_stack.pop_back();
+
+			if(lowlink[v] == index[v])
+			{
+				// v is the root of a component.  Its members are everything above it on the stack.
+				std::size_t component = is_recursive->size();
+				std::size_t member;
+				bool recursive = std::binary_search(callees[v].begin(), callees[v].end(), v);
+
+				do
+				{
+					member = component_stack.back();
+					component_stack.pop_back();
+					on_stack[member] = false;
+					m_component_of_function[member] = component;
+					if(member != v)
+					{
+						recursive = true;
+					}
+				} while(member != v);
+
+				is_recursive->push_back(recursive);
+			}
+
+			if(!call_stack.empty())
+			{
+				std::size_t u = call_stack.back().first;
+				lowlink[u] = std::min(lowlink[u], lowlink[v]);
+			}
+		}
+	}
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+ *
+ * This file is part of CoFlo.
+ *
+ * CoFlo is free software: you can redistribute it and/or modify it under the
+ * terms of version 3 of the GNU General Public License as published by the Free
+ * Software Foundation.
+ *
+ * CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file */
+
+#ifndef CALLGRAPHREACHABILITYINDEX_H
+#define CALLGRAPHREACHABILITYINDEX_H
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/unordered_map.hpp>
+
+class ControlFlowGraph;
+class Function;
+
+/**
+ * Index answering "could Function f1 ever call Function f2, directly or through other calls" in constant time.
+ *
+ * The index is built from the program's call graph, which has an edge from f1 to f2 wherever f1 contains a
+ * resolved call of f2, whether or not the call can actually be reached.  The strongly connected components of
+ * the call graph are condensed to single nodes, and each component gets a bitset of the components reachable
+ * from it, computed bottom-up over the condensation.  A query is two hash lookups and a bit test.
+ *
+ * The answer is conservative: if MayReach() says no, no path through the control flow graph can get from one
+ * Function to the other, and the constraint can be dismissed without looking further.  If it says yes, the
+ * path may still be impossible, e.g. because the call is never reached or an earlier call never returns.
+ *
+ * The bitsets take (number of components)^2 bits.  That's about 12 MB for ten thousand non-recursive Functions.
+ */
+class CallGraphReachabilityIndex : boost::noncopyable
+{
+public:
+	/**
+	 * Build the index over all the Functions in @a cfg.
+	 *
+	 * @param cfg The whole-program control flow graph, with its function calls linked.
+	 */
+	explicit CallGraphReachabilityIndex(ControlFlowGraph &cfg);
+	~CallGraphReachabilityIndex();
+
+	/**
+	 * Could the entry of @a sink be reached from the entry of @a source, by way of at least one call?
+	 *
+	 * @return false if it certainly can't.
+	 */
+	bool MayReach(const Function *source, const Function *sink) const;
+
+	/// @return The number of Functions in the call graph.
+	std::size_t GetNumberOfFunctions() const { return m_component_of_function.size(); };
+
+	/// @return The number of strongly connected components the call graph condensed to.
+	std::size_t GetNumberOfComponents() const { return m_reachable_components.size(); };
+
+	/**
+	 * @name The strongly connected components themselves.
+	 *
+	 * Components are numbered so that every component a component calls into has a lower number than it does.
+	 * Visiting components in increasing order therefore always visits callees before their callers.
+	 */
+	//@{
+
+	/// @return The component of @a f, which must have vertices in the graph the index was built over.
+	std::size_t GetComponent(const Function *f) const { return m_component_of_function[m_function_numbers.find(f)->second]; };
+
+	/// @return The Functions in component @a c.
+	const std::vector<const Function*>& GetComponentMembers(std::size_t c) const { return m_component_members[c]; };
+
+	/// @return The components reachable from component @a c through one or more calls, as a bitset of component numbers.
+	const boost::dynamic_bitset<>& GetReachableComponents(std::size_t c) const { return m_reachable_components[c]; };
+
+	//@}
+
+private:
+
+	/**
+	 * Number the strongly connected components of the call graph in reverse topological order, so every
+	 * component's callees have lower numbers than it does, and fill in m_component_of_function.
+	 *
+	 * @param callees The callees of each Function, by Function number.
+	 * @param is_recursive Receives, by component number, whether the component contains a cycle of calls.
+	 */
+	void FindComponents(const std::vector< std::vector<std::size_t> > &callees, std::vector<bool> *is_recursive);
+
+	/// The number of each Function in the call graph.
+	boost::unordered_map<const Function*, std::size_t> m_function_numbers;
+
+	/// The component each Function belongs to, by Function number.
+	std::vector<std::size_t> m_component_of_function;
+
+	/// The Functions in each component, by component number.
+	std::vector< std::vector<const Function*> > m_component_members;
+
+	/// The components reachable from each component through one or more calls, by component number.
+	std::vector< boost::dynamic_bitset<> > m_reachable_components;
+};
+
+#endif /* CALLGRAPHREACHABILITYINDEX_H */
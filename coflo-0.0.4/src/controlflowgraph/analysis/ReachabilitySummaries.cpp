@@ -0,0 +1,358 @@
+/*
+ * Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+ *
+ * This file is part of CoFlo.
+ *
+ * CoFlo is free software: you can redistribute it and/or modify it under the
+ * terms of version 3 of the GNU General Public License as published by the Free
+ * Software Foundation.
+ *
+ * CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file */
+
+#include "ReachabilitySummaries.h"
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+#include <boost/foreach.hpp>
+#include <boost/unordered_set.hpp>
+
+#include "../ControlFlowGraphSnapshot.h"
+#include "../statements/statements.h"
+#include "CallGraphReachabilityIndex.h"
+#include "Function.h"
+
+ReachabilitySummaries::ReachabilitySummaries(ControlFlowGraph &cfg, const CallGraphReachabilityIndex &index)
+	: m_cfg(cfg), m_index(index), m_component_done(index.GetNumberOfComponents(), false)
+{
+	m_slice = &m_cfg.GetSlice(IsRelevantToReachability);
+}
+
+ReachabilitySummaries::~ReachabilitySummaries()
+{
+}
+
+bool ReachabilitySummaries::IsRelevantToReachability(StatementBase *statement)
+{
+	// Function entry and exit points, because that's what we're searching for and how we get back out of
+	// calls, and calls and decisions, because those are what a reported path is made of.
+	return statement->IsType<Entry>() || statement->IsType<Exit>()
+			|| statement->IsFunctionCall() || statement->IsDecisionStatement();
+}
+
+bool ReachabilitySummaries::CanReach(const Function *source, const Function *sink)
+{
+	const Summary &summary = GetSummary(source);
+
+	return std::binary_search(summary.m_reachable_functions.begin(), summary.m_reachable_functions.end(), sink);
+}
+
+void ReachabilitySummaries::GetWitnessPaths(const Function *source, const std::vector<const Function*> &sinks,
+		std::vector< std::deque<T_CFG_EDGE_DESC> > *paths)
+{
+	// Follow the calls the source can reach, breadth first, noting which body each callee was first called
+	// from.  NULL stands for the body of the source itself, where the search starts, since the source can
+	// also turn up as a callee if it's recursive.
+	boost::unordered_map<const Function*, const Function*> called_from;
+	boost::unordered_set<const Function*> sinks_not_reached(sinks.begin(), sinks.end());
+	std::deque<const Function*> queue;
+
+	queue.push_back(NULL);
+	while(!queue.empty() && !sinks_not_reached.empty())
+	{
+		const Function *caller = queue.front();
+		queue.pop_front();
+
+		BOOST_FOREACH(const Function *callee, GetSummary((caller == NULL) ? source : caller).m_reachable_callees)
+		{
+			if(called_from.insert(std::make_pair(callee, caller)).second)
+			{
+				sinks_not_reached.erase(callee);
+				queue.push_back(callee);
+			}
+		}
+	}
+
+	// Now spell out the path to each sink, one call at a time, walking each Function on the way only once.
+	// Several threads may be doing this at once, so each call gets its own scratch space.
+	WalkScratch scratch;
+	boost::unordered_map<const Function*, CallSites> call_sites;
+	paths->assign(sinks.size(), std::deque<T_CFG_EDGE_DESC>());
+	for(std::size_t i = 0; i < sinks.size(); ++i)
+	{
+		boost::unordered_map<const Function*, const Function*>::const_iterator it = called_from.find(sinks[i]);
+
+		if(it == called_from.end())
+		{
+			// Not reachable.
+			continue;
+		}
+
+		// Collect the calls on the way from the sink back to the source, as (caller, callee) pairs.
+		std::vector< std::pair<const Function*, const Function*> > calls;
+		const Function *callee = sinks[i];
+		const Function *caller = it->second;
+		while(caller != NULL)
+		{
+			calls.push_back(std::make_pair(caller, callee));
+			callee = caller;
+			caller = called_from[caller];
+		}
+		calls.push_back(std::make_pair(source, callee));
+
+		std::deque<T_CFG_EDGE_DESC> &path = (*paths)[i];
+		path.push_back(source->GetEntrySelfEdgeDescriptor());
+		for(std::size_t j = calls.size(); j-- > 0; )
+		{
+			boost::unordered_map<const Function*, CallSites>::iterator sites = call_sites.find(calls[j].first);
+
+			if(sites == call_sites.end())
+			{
+				sites = call_sites.insert(std::make_pair(calls[j].first, CallSites())).first;
+				FindCallSites(calls[j].first, &scratch, &sites->second);
+			}
+			AppendPathToCall(calls[j].first, sites->second, calls[j].second, &path);
+		}
+	}
+}
+
+const ReachabilitySummaries::Summary& ReachabilitySummaries::GetSummary(const Function *f)
+{
+	std::size_t c = m_index.GetComponent(f);
+
+	if(!m_component_done[c])
+	{
+		Summarize(c);
+	}
+
+	return m_summaries.find(f)->second;
+}
+
+void ReachabilitySummaries::Summarize(std::size_t c)
+{
+	const boost::dynamic_bitset<> &reachable = m_index.GetReachableComponents(c);
+
+	// Everything c calls into has a lower number than c, and everything those call into is reachable from c
+	// too, so going through them in increasing order always finds a component's callees already done.
+	for(std::size_t d = reachable.find_first(); d < c; d = reachable.find_next(d))
+	{
+		if(!m_component_done[d])
+		{
+			SummarizeComponent(d);
+		}
+	}
+
+	SummarizeComponent(c);
+}
+
+void ReachabilitySummaries::SummarizeComponent(std::size_t c)
+{
+	const std::vector<const Function*> &component = m_index.GetComponentMembers(c);
+	bool changed;
+
+	// Whether a Function can return depends on whether the calls it makes can, so a cycle of calls has to be
+	// rescanned until that stops changing.  It only ever changes from false to true, so this terminates.
+	do
+	{
+		changed = false;
+		BOOST_FOREACH(const Function *f, component)
+		{
+			Summary &summary = m_summaries[f];
+			bool could_return = summary.m_can_return;
+
+			ScanFunction(f, &summary);
+			if(summary.m_can_return != could_return)
+			{
+				changed = true;
+			}
+		}
+	} while(changed);
+
+	// Now gather up everything each Function can reach through the calls it can reach.  Callees outside the
+	// component are already complete, so a single pass does it unless the component is a cycle.
+	do
+	{
+		changed = false;
+		BOOST_FOREACH(const Function *f, component)
+		{
+			Summary &summary = m_summaries[f];
+			std::vector<const Function*> reachable(summary.m_reachable_callees);
+
+			BOOST_FOREACH(const Function *callee, summary.m_reachable_callees)
+			{
+				const std::vector<const Function*> &callee_reachable = m_summaries[callee].m_reachable_functions;
+				std::vector<const Function*> merged;
+
+				std::set_union(reachable.begin(), reachable.end(), callee_reachable.begin(), callee_reachable.end(),
+						std::back_inserter(merged));
+				reachable.swap(merged);
+			}
+
+			if(reachable.size() != summary.m_reachable_functions.size())
+			{
+				summary.m_reachable_functions.swap(reachable);
+				changed = true;
+			}
+		}
+	} while(changed);
+
+	m_component_done[c] = true;
+}
+
+void ReachabilitySummaries::ScanFunction(const Function *f, Summary *summary)
+{
+	typedef boost::color_traits<boost::default_color_type> T_COLOR;
+
+	const FunctionVertexRange &range = m_cfg.GetFunctionVertexRange(f);
+	T_CFG_VERTEX_DESC exit = f->GetExitVertexDescriptor();
+	ControlFlowGraphSnapshot::out_edge_iterator ei, eend;
+	const Function *callee;
+
+	summary->m_reachable_callees.clear();
+
+	m_scratch.m_visited.Reset(&range);
+	m_scratch.m_queue.clear();
+	m_scratch.m_queue.push_back(f->GetEntryVertexDescriptor());
+	m_scratch.m_visited.set(m_scratch.m_queue.back(), T_COLOR::black());
+
+	for(std::size_t head = 0; head < m_scratch.m_queue.size(); ++head)
+	{
+		T_CFG_VERTEX_DESC u = m_scratch.m_queue[head];
+
+		if(u == exit)
+		{
+			summary->m_can_return = true;
+		}
+
+		for(boost::tie(ei, eend) = m_slice->OutEdges(u); ei != eend; ++ei)
+		{
+			switch(ClassifyEdge(u, ei, &callee))
+			{
+				case CALL_EDGE:
+					summary->m_reachable_callees.push_back(callee);
+					break;
+				case FOLLOW_EDGE:
+					if(m_scratch.m_visited.get(ei->m_target) == T_COLOR::white())
+					{
+						m_scratch.m_visited.set(ei->m_target, T_COLOR::black());
+						m_scratch.m_queue.push_back(ei->m_target);
+					}
+					break;
+				default:
+					break;
+			}
+		}
+	}
+
+	std::sort(summary->m_reachable_callees.begin(), summary->m_reachable_callees.end());
+	summary->m_reachable_callees.erase(std::unique(summary->m_reachable_callees.begin(), summary->m_reachable_callees.end()),
+			summary->m_reachable_callees.end());
+}
+
+ReachabilitySummaries::EdgeAction ReachabilitySummaries::ClassifyEdge(T_CFG_VERTEX_DESC u,
+		ControlFlowGraphSnapshot::out_edge_iterator ei, const Function **callee) const
+{
+	ControlFlowGraphSnapshot::T_EDGE_KIND kind = m_slice->GetOutEdgeKind(ei);
+
+	if(kind & (ControlFlowGraphSnapshot::EDGE_KIND_BACK_EDGE | ControlFlowGraphSnapshot::EDGE_KIND_IMPOSSIBLE
+			| ControlFlowGraphSnapshot::EDGE_KIND_RETURN))
+	{
+		// Loops add no new paths, impossible edges can't be taken, and where a return goes is the caller's business.
+		return SKIP_EDGE;
+	}
+
+	if(kind & ControlFlowGraphSnapshot::EDGE_KIND_FUNCTION_CALL)
+	{
+		*callee = m_slice->GetOutEdgeFunctionCall(ei)->m_target_function;
+		return CALL_EDGE;
+	}
+
+	if(kind & ControlFlowGraphSnapshot::EDGE_KIND_FUNCTION_CALL_BYPASS)
+	{
+		// Execution only gets past the call if the callee returns.  The callee's summary is either complete,
+		// or it's in the component being summarized and holds the best answer so far, if it's been started.
+		StatementBase *statement = m_slice->GetStatementPtr(u);
+
+		if(statement->IsType<FunctionCallResolved>())
+		{
+			*callee = static_cast<FunctionCallResolved*>(statement)->m_target_function;
+			boost::unordered_map<const Function*, Summary>::const_iterator it = m_summaries.find(*callee);
+
+			return (it != m_summaries.end() && it->second.m_can_return) ? FOLLOW_EDGE : SKIP_EDGE;
+		}
+	}
+
+	return FOLLOW_EDGE;
+}
+
+void ReachabilitySummaries::FindCallSites(const Function *f, WalkScratch *scratch, CallSites *call_sites) const
+{
+	typedef boost::color_traits<boost::default_color_type> T_COLOR;
+
+	const FunctionVertexRange &range = m_cfg.GetFunctionVertexRange(f);
+	ControlFlowGraphSnapshot::out_edge_iterator ei, eend;
+	const Function *callee;
+
+	scratch->m_visited.Reset(&range);
+	scratch->m_queue.clear();
+	scratch->m_queue.push_back(f->GetEntryVertexDescriptor());
+	scratch->m_visited.set(scratch->m_queue.back(), T_COLOR::black());
+
+	for(std::size_t head = 0; head < scratch->m_queue.size(); ++head)
+	{
+		T_CFG_VERTEX_DESC u = scratch->m_queue[head];
+
+		for(boost::tie(ei, eend) = m_slice->OutEdges(u); ei != eend; ++ei)
+		{
+			switch(ClassifyEdge(u, ei, &callee))
+			{
+				case CALL_EDGE:
+					// Breadth first, so the first call of each callee we come to is the nearest.
+					call_sites->m_call_edges.insert(std::make_pair(callee, *ei));
+					break;
+				case FOLLOW_EDGE:
+					if(scratch->m_visited.get(ei->m_target) == T_COLOR::white())
+					{
+						scratch->m_visited.set(ei->m_target, T_COLOR::black());
+						call_sites->m_parent_edges[ei->m_target] = *ei;
+						scratch->m_queue.push_back(ei->m_target);
+					}
+					break;
+				default:
+					break;
+			}
+		}
+	}
+}
+
+void ReachabilitySummaries::AppendPathToCall(const Function *f, const CallSites &call_sites, const Function *callee,
+		std::deque<T_CFG_EDGE_DESC> *path) const
+{
+	boost::unordered_map<const Function*, T_CFG_EDGE_DESC>::const_iterator call = call_sites.m_call_edges.find(callee);
+
+	if(call == call_sites.m_call_edges.end())
+	{
+		// The summaries say the call is there, so we can't get here.
+		std::cerr << "ERROR: No call of " << callee->GetIdentifier() << "() found in function " << f->GetIdentifier() << "()." << std::endl;
+		return;
+	}
+
+	// Walk the parent edges back from the call to the entry.
+	std::deque<T_CFG_EDGE_DESC> segment;
+	segment.push_front(call->second);
+	for(T_CFG_VERTEX_DESC v = call->second.m_source; v != f->GetEntryVertexDescriptor(); v = segment.front().m_source)
+	{
+		segment.push_front(call_sites.m_parent_edges.find(v)->second);
+	}
+
+	path->insert(path->end(), segment.begin(), segment.end());
+}
@@ -0,0 +1,197 @@
+/*
+ * Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+ *
+ * This file is part of CoFlo.
+ *
+ * CoFlo is free software: you can redistribute it and/or modify it under the
+ * terms of version 3 of the GNU General Public License as published by the Free
+ * Software Foundation.
+ *
+ * CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file */
+
+#ifndef REACHABILITYSUMMARIES_H
+#define REACHABILITYSUMMARIES_H
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+#include <boost/unordered_map.hpp>
+
+#include "../ControlFlowGraph.h"
+#include "../FunctionColorMap.h"
+
+class Function;
+class CallGraphReachabilityIndex;
+
+/**
+ * Interprocedural reachability summaries, one per Function: whether the Function can return, which callees
+ * it can reach a call of, and which Functions it can reach the entry of through any chain of calls.
+ *
+ * A summary describes a Function once, for every context it's called in, so answering "can f1() reach f2()"
+ * never walks the same callee twice.  Summaries are computed on demand, for the Functions a query needs, a
+ * whole strongly connected component of the call graph at a time.  The components are the ones the
+ * CallGraphReachabilityIndex found, taken in its order, which finishes each Function's callees before the
+ * Function itself.  The Functions of a recursive cycle are iterated together until their summaries stop
+ * changing.
+ *
+ * Within a Function, the summaries follow the same edges a reachability search of the CFG would.  Back edges,
+ * impossible edges and returns are never followed.  A call's bypass edge is followed only if the callee can
+ * return, which is exactly when the search would have come back out of the call.
+ *
+ * Summaries refer to the graph's reachability slice, so the graph must not be modified while they're in use.
+ * Computing summaries isn't thread-safe.  Once Precompute() has been called for every source Function a query
+ * will start from, CanReach() and GetWitnessPaths() from those sources only read shared state,
+ * and any number of threads can call them at once.
+ */
+class ReachabilitySummaries : boost::noncopyable
+{
+public:
+	/**
+	 * @param cfg The graph to summarize.
+	 * @param index The call graph index built over @a cfg, whose components the summaries are computed by.
+	 */
+	ReachabilitySummaries(ControlFlowGraph &cfg, const CallGraphReachabilityIndex &index);
+	~ReachabilitySummaries();
+
+	/**
+	 * Slice predicate selecting the statements reachability checking needs to see: function entry and exit
+	 * points, calls, and decisions.
+	 */
+	static bool IsRelevantToReachability(StatementBase *statement);
+
+	/**
+	 * Compute the summaries of @a f and of every Function it calls, directly or not, if they haven't been
+	 * already.  Queries starting from @a f will then never need to compute another summary.
+	 */
+	void Precompute(const Function *f) { GetSummary(f); };
+
+	/**
+	 * Can the entry of @a sink be reached from the entry of @a source, by way of at least one call?  So a
+	 * Function only reaches itself if it can recurse.
+	 */
+	bool CanReach(const Function *source, const Function *sink);
+
+	/**
+	 * Find a path from the entry of @a source to the entry of each of @a sinks, all in one search.
+	 *
+	 * The search follows reachable calls breadth first from @a source, so each path goes through as few calls
+	 * as possible, and stops as soon as every sink has been reached.  Each Function the paths go through is
+	 * walked once, however many of the paths share it.  Calls along the way which return are stepped over by
+	 * their bypass edges rather than being expanded.
+	 *
+	 * @param source The Function to start from.
+	 * @param sinks The Functions to reach.
+	 * @param paths Receives one path per sink, in the same order.  Each starts with @a source's entry self
+	 *        edge and ends with a call of the sink.  The path to a sink which CanReach() says can't be reached
+	 *        is left empty.
+	 */
+	void GetWitnessPaths(const Function *source, const std::vector<const Function*> &sinks,
+			std::vector< std::deque<T_CFG_EDGE_DESC> > *paths);
+
+private:
+
+	/// Everything we know about one Function.
+	struct Summary
+	{
+		Summary() : m_can_return(false) {};
+
+		/// Whether the Function's Exit can be reached from its Entry.
+		bool m_can_return;
+
+		/// The Functions whose calls can be reached from the Function's Entry, sorted.
+		std::vector<const Function*> m_reachable_callees;
+
+		/// The Functions whose Entry can be reached through any chain of calls, sorted.
+		std::vector<const Function*> m_reachable_functions;
+	};
+
+	/// What a walk of a Function does with one of its out edges.
+	enum EdgeAction
+	{
+		/// Pretend the edge isn't there.
+		SKIP_EDGE,
+		/// Follow the edge to another vertex of the same Function.
+		FOLLOW_EDGE,
+		/// The edge is a call.  Note the callee, but don't follow it.
+		CALL_EDGE
+	};
+
+	/// Return the completed summary of @a f, computing it and those of its callees first if need be.
+	const Summary& GetSummary(const Function *f);
+
+	/// Summarize call graph component @a c, and every component it calls into, if they haven't been already.
+	void Summarize(std::size_t c);
+
+	/// Iterate the summaries of the Functions of call graph component @a c until they stop changing.
+	void SummarizeComponent(std::size_t c);
+
+	/// Walk @a f from its Entry, recording whether it can return and which calls it reaches.
+	void ScanFunction(const Function *f, Summary *summary);
+
+	/// Decide what a walk should do with out edge @a ei of vertex @a u.  Sets @a *callee for calls and bypasses.
+	EdgeAction ClassifyEdge(T_CFG_VERTEX_DESC u, ControlFlowGraphSnapshot::out_edge_iterator ei, const Function **callee) const;
+
+	/// The shortest paths from a Function's Entry to each of the calls it can reach.
+	struct CallSites
+	{
+		/// The edge each reached vertex was first reached by.
+		boost::unordered_map<T_CFG_VERTEX_DESC, T_CFG_EDGE_DESC> m_parent_edges;
+
+		/// The first call edge reached for each callee.
+		boost::unordered_map<const Function*, T_CFG_EDGE_DESC> m_call_edges;
+	};
+
+	/// Scratch space for walks of one Function.
+	struct WalkScratch
+	{
+		FunctionColorMap m_visited;
+		std::vector<T_CFG_VERTEX_DESC> m_queue;
+	};
+
+	/**
+	 * Walk @a f from its Entry, breadth first, recording in @a call_sites how each reachable call is reached.
+	 * Only reads the summaries, so it's safe to call concurrently with different @a scratch.
+	 */
+	void FindCallSites(const Function *f, WalkScratch *scratch, CallSites *call_sites) const;
+
+	/**
+	 * Append the path from the Entry of @a f to its call of @a callee, the call edge included, to @a path.
+	 *
+	 * @param f The calling Function.
+	 * @param call_sites The result of FindCallSites() for @a f.
+	 * @param callee The Function called.  The call must be one of those in @a call_sites.
+	 * @param path The path to append to.
+	 */
+	void AppendPathToCall(const Function *f, const CallSites &call_sites, const Function *callee,
+			std::deque<T_CFG_EDGE_DESC> *path) const;
+
+	/// The graph we summarize.
+	ControlFlowGraph &m_cfg;
+
+	/// The call graph, condensed to its strongly connected components.
+	const CallGraphReachabilityIndex &m_index;
+
+	/// The slice of m_cfg which the walks follow.
+	const ControlFlowGraphSnapshot *m_slice;
+
+	/// The summaries computed or started so far.
+	boost::unordered_map<const Function*, Summary> m_summaries;
+
+	/// Whether the summaries of each call graph component are complete, by component number.
+	std::vector<bool> m_component_done;
+
+	/// Scratch space for the walks which compute summaries.
+	WalkScratch m_scratch;
+};
+
+#endif /* REACHABILITYSUMMARIES_H */
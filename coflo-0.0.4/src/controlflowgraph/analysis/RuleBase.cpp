@@ -33,7 +33,13 @@ void RuleBase::indent(long i)
 {
 	while (i > 0)
 	{
-		std::cout << "    ";
+		m_report << "    ";
 		i--;
 	};
 }
+
+void RuleBase::EndReport()
+{
+	m_reports.push_back(m_report.str());
+	m_report.str("");
+}
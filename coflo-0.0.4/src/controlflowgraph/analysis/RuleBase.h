@@ -18,10 +18,19 @@
 #ifndef RULEBASE_H
 #define	RULEBASE_H
 
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include "../ControlFlowGraph.h"
 
 /**
  * Abstract base class for all rules.
+ *
+ * Rules write what they find to their own reports rather than straight to std::cout, so several rules can run
+ * at once on different threads.  The caller prints the reports once the rules are done.  A rule which checks
+ * several constraints at once writes one report per constraint, so the caller can print them in whatever
+ * order the constraints were given in.
  */
 class RuleBase
 {
@@ -32,10 +41,26 @@ public:
 	virtual ~RuleBase();
 	
 	virtual bool RunRule() = 0;
+
+	/// @return The number of reports RunRule() wrote.
+	std::size_t GetNumberOfReports() const { return m_reports.size(); };
+
+	/// @return Report number @a i which RunRule() wrote.
+	const std::string& GetReport(std::size_t i) const { return m_reports[i]; };
 	
 protected:
 
-	static void indent(long i);
+	/// Write @a i levels of indentation to m_report.
+	void indent(long i);
+
+	/// Finish the report being written to m_report, and start a new one.
+	void EndReport();
+
+	/// The report being written.
+	std::ostringstream m_report;
+
+	/// The finished reports.
+	std::vector<std::string> m_reports;
 
 private:
 
@@ -21,94 +21,95 @@
 
 #include <iostream>
 
-#include <boost/graph/depth_first_search.hpp>
 #include <boost/foreach.hpp>
 
 #include "../ControlFlowGraph.h"
-#include "../ControlFlowGraphTraversalDFS.h"
-#include "../visitors/ReachabilityVisitor.h"
-#include "../statements/Entry.h"
+#include "CallGraphReachabilityIndex.h"
+#include "ReachabilitySummaries.h"
 #include "Function.h"
 
 #include "../statements/Entry.h"
 
-RuleReachability::RuleReachability(ControlFlowGraph &cfg, const Function *source, const Function *sink) : RuleDFSBase(cfg)
+RuleReachability::RuleReachability(ControlFlowGraph &cfg, const CallGraphReachabilityIndex *index,
+		ReachabilitySummaries *summaries, const Function *source) : m_cfg(cfg)
 {
+	m_index = index;
+	m_summaries = summaries;
 	m_source = source;
-	m_sink = sink;
 }
 
-RuleReachability::RuleReachability(const RuleReachability& orig) : RuleDFSBase(orig)
+RuleReachability::RuleReachability(const RuleReachability& orig) : RuleBase(orig), m_cfg(orig.m_cfg)
 {
+	m_index = orig.m_index;
+	m_summaries = orig.m_summaries;
 	m_source = orig.m_source;
-	m_sink = orig.m_sink;
+	m_sinks = orig.m_sinks;
 }
 
 RuleReachability::~RuleReachability()
 {
 }
 
-/**
- * This is the predicate which will be called by the ReachabilityVisitor as it visits each vertex.
- * It will return true to indicate that the target vertex was discovered.
- */
-struct ReachabilityPredicateSpecificVertex
+bool RuleReachability::RunRule()
 {
-	ReachabilityPredicateSpecificVertex(T_CFG_VERTEX_DESC sink) { m_sink = sink; };
+	std::vector<const Function*> violated_sinks;
+	std::vector< std::deque<T_CFG_EDGE_DESC> > paths;
+
+	m_report.str("");
+	m_reports.clear();
 
-	bool operator()(ControlFlowGraph &cfg, T_CFG_VERTEX_DESC &v)
+	// If no chain of calls leads from the source to a sink, there's nothing more to check.  Otherwise the
+	// summaries know whether there's a violation without walking the graph.
+	BOOST_FOREACH(const Function *sink, m_sinks)
 	{
-		if(v == m_sink)
+		if(m_index->MayReach(m_source, sink) && m_summaries->CanReach(m_source, sink))
 		{
-			return true;
+			violated_sinks.push_back(sink);
 		}
-
-		return false;
 	}
 
-	/// The vertex we're trying to find.
-	T_CFG_VERTEX_DESC m_sink;
-};
-
-bool RuleReachability::RunRule()
-{
-	T_CFG_VERTEX_DESC starting_vertex_desc;
-
-	// Get the starting vertex.
-	starting_vertex_desc = m_source->GetEntryVertexDescriptor();
-
-	// Push a fake edge onto the predecessor stack, since our last vertex will try to pop it.
-	m_predecessors.push_back(m_source->GetEntrySelfEdgeDescriptor());
+	// Find the paths to show for all the violations in one go.
+	if(!violated_sinks.empty())
+	{
+		m_summaries->GetWitnessPaths(m_source, violated_sinks, &paths);
+	}
 
-	// Set up a visitor.
-	ReachabilityPredicateSpecificVertex pred(m_sink->GetEntryVertexDescriptor());
-	ReachabilityVisitor v(m_cfg, starting_vertex_desc, pred, &m_predecessors);
+	std::size_t next_violation = 0;
+	BOOST_FOREACH(const Function *sink, m_sinks)
+	{
+		m_predecessors.clear();
+		if(next_violation < violated_sinks.size() && violated_sinks[next_violation] == sink)
+		{
+			m_predecessors.swap(paths[next_violation]);
+			++next_violation;
+		}
 
-	// Create a depth-first-search graph traversal object.
-	ControlFlowGraphTraversalDFS traversal(m_cfg);
+		ReportConstraint(sink);
+		EndReport();
+	}
 
-	// Traverse the CFG.
-	traversal.Traverse(starting_vertex_desc, &v);
+	return true;
+}
 
+void RuleReachability::ReportConstraint(const Function *sink)
+{
 	if(!m_predecessors.empty())
 	{
 		StatementBase *violating_statement = m_cfg.GetStatementPtr(m_predecessors.rbegin()->m_source);
-		std::cout << m_source->GetDefinitionFilePath() << ": In function " << m_source->GetIdentifier() << ":" << std::endl;
-		std::cout << violating_statement->GetLocation().asGNUCompilerMessageLocation()
+		m_report << m_source->GetDefinitionFilePath() << ": In function " << m_source->GetIdentifier() << ":" << std::endl;
+		m_report << violating_statement->GetLocation().asGNUCompilerMessageLocation()
 				<< ": warning: constraint violation: path exists in control flow graph to " << violating_statement->GetIdentifierCFG() << std::endl;
-		std::cout << violating_statement->GetLocation().asGNUCompilerMessageLocation() << ": warning: violating path follows" << std::endl;
+		m_report << violating_statement->GetLocation().asGNUCompilerMessageLocation() << ": warning: violating path follows" << std::endl;
 		PrintCallChain();
 	}
 	else
 	{
-		std::cout << "Couldn't find a violation of constraint: "
+		m_report << "Couldn't find a violation of constraint: "
 				<< m_source->GetIdentifier()
 				<< "() -x "
-				<< m_sink->GetIdentifier() << "()"
+				<< sink->GetIdentifier() << "()"
 				<< std::endl;
 	}
-
-	return true;
 }
 
 void RuleReachability::PrintCallChain()
@@ -169,7 +170,7 @@ void RuleReachability::PrintCallChain()
 		else if(sb->IsDecisionStatement())
 		{
 			// It's a decision statement
-			PrintStatement(sb, m_cfg.GetEdgeTypePtr(pred), indent_level);
+			PrintStatement(sb, m_cfg.GetEdgeType(pred), indent_level);
 		}
 		else if(sb->IsType<Entry>())
 		{
@@ -184,16 +185,16 @@ void RuleReachability::PrintCallChain()
 
 void RuleReachability::PrintStatement(StatementBase *fc, long indent_level)
 {
-	std::cout << fc->GetLocation().asGNUCompilerMessageLocation() << ": warning: ";
+	m_report << fc->GetLocation().asGNUCompilerMessageLocation() << ": warning: ";
 	indent(indent_level);
-	std::cout << fc->GetIdentifierCFG() << std::endl;
+	m_report << fc->GetIdentifierCFG() << std::endl;
 }
 
-void RuleReachability::PrintStatement(StatementBase *sb, CFGEdgeTypeBase *eb, long  indent_level)
+void RuleReachability::PrintStatement(StatementBase *sb, const CFGEdgeTypeBase &eb, long  indent_level)
 {
-	std::cout << sb->GetLocation().asGNUCompilerMessageLocation() << ": warning: ";
+	m_report << sb->GetLocation().asGNUCompilerMessageLocation() << ": warning: ";
 	indent(indent_level);
-	std::cout << sb->GetIdentifierCFG() << ", taking out edge \"" << eb->GetLabel() << "\"" << std::endl;
+	m_report << sb->GetIdentifierCFG() << ", taking out edge \"" << eb.GetLabel() << "\"" << std::endl;
 }
 
 
@@ -21,38 +21,67 @@
 #define	RULEREACHABILITY_H
 
 #include <deque>
+#include <vector>
 
-#include "RuleDFSBase.h"
+#include "RuleBase.h"
 
 class ControlFlowGraph;
 class Function;
+class CallGraphReachabilityIndex;
+class ReachabilitySummaries;
 
-class RuleReachability : public RuleDFSBase
+/**
+ * Rule checking all the constraints "@a source() -x sink()" with the same @a source: that no path through the
+ * control flow graph leads from the entry of @a source to a call of any of the sinks.
+ *
+ * The call graph index the rule is given dismisses most constraints outright.  The rest are answered by the
+ * ReachabilitySummaries, which every rule checking the same program shares.  Only the violated constraints
+ * need the graph walked, and a single search from @a source finds the paths to all of their sinks.  Each
+ * constraint gets its own report, numbered in the order the sinks were added.
+ */
+class RuleReachability : public RuleBase
 {
 public:
-	RuleReachability(ControlFlowGraph &cfg, const Function *source, const Function *sink);
+	RuleReachability(ControlFlowGraph &cfg, const CallGraphReachabilityIndex *index, ReachabilitySummaries *summaries,
+			const Function *source);
 	RuleReachability(const RuleReachability& orig);
 	virtual ~RuleReachability();
+
+	/**
+	 * Add the constraint that @a sink must not be reachable from the source.
+	 *
+	 * @return The number of the report RunRule() will write for the constraint.
+	 */
+	std::size_t AddSink(const Function *sink) { m_sinks.push_back(sink); return m_sinks.size() - 1; };
 	
 	virtual bool RunRule();
 	
 	void PrintCallChain();
 	
 private:
+
+	/// Report whether the constraint that @a sink is unreachable holds, given the path found to it in m_predecessors.
+	void ReportConstraint(const Function *sink);
 	
 	void PrintStatement(StatementBase *fc, long indent_level);
-	void PrintStatement(StatementBase *sb, CFGEdgeTypeBase *eb, long indent_level);
+	void PrintStatement(StatementBase *sb, const CFGEdgeTypeBase &eb, long indent_level);
+
+	/// The control flow graph the paths are in.
+	ControlFlowGraph &m_cfg;
+
+	/// The index which rules out constraints which can't possibly be violated.
+	const CallGraphReachabilityIndex *m_index;
 
-	/// Flag which we'll set when we find m_sink to stop the search.
-	bool m_found_sink;
+	/// The summaries the rule is checked against.
+	ReachabilitySummaries *m_summaries;
 
-	/// The function which must not call m_sink.
+	/// The function which must not call any of m_sinks.
 	const Function *m_source;
 	
-	/// The function which must not be called from m_sink.
-	const Function *m_sink;
+	/// The functions which must not be called from m_source.
+	std::vector<const Function*> m_sinks;
 	
-	/// Array to store predecessor of each visited vertex.
+	/// The path to the sink being reported.
 	std::deque<T_CFG_EDGE_DESC> m_predecessors;
 };
 
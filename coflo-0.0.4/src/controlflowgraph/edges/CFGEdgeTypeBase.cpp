@@ -19,24 +19,55 @@
 
 #include "CFGEdgeTypeBase.h"
 
+#include "edge_types.h"
+
+/// @name The shared instances of each edge type.
+//@{
+static const CFGEdgeTypeFallthrough f_fallthrough;
+static const CFGEdgeTypeIfTrue f_if_true;
+static const CFGEdgeTypeIfFalse f_if_false;
+static const CFGEdgeTypeGoto f_goto;
+static const CFGEdgeTypeFunctionCall f_function_call;
+static const CFGEdgeTypeReturn f_return;
+static const CFGEdgeTypeFunctionCallBypass f_function_call_bypass;
+static const CFGEdgeTypeImpossible f_impossible;
+static const CFGEdgeTypeExceptional f_exceptional;
+//@}
+
+const CFGEdgeTypeBase& CFGEdgeTypeBase::GetEdgeType(CFGEdgeKind kind)
+{
+	switch(kind.as_enum())
+	{
+		case CFGEdgeKind::fallthrough: return f_fallthrough;
+		case CFGEdgeKind::if_true: return f_if_true;
+		case CFGEdgeKind::if_false: return f_if_false;
+		case CFGEdgeKind::jump: return f_goto;
+		case CFGEdgeKind::function_call: return f_function_call;
+		case CFGEdgeKind::function_return: return f_return;
+		case CFGEdgeKind::function_call_bypass: return f_function_call_bypass;
+		case CFGEdgeKind::impossible: return f_impossible;
+		case CFGEdgeKind::exceptional: return f_exceptional;
+	}
+
+	// Should never get here.
+	return f_fallthrough;
+}
+
 CFGEdgeTypeBase::CFGEdgeTypeBase()
 {
-	// We're not a back edge until told otherwise.
-	m_is_back_edge = false;
 }
 
 CFGEdgeTypeBase::CFGEdgeTypeBase(const CFGEdgeTypeBase& orig)
 {
-	m_is_back_edge = orig.m_is_back_edge;
 }
 
 CFGEdgeTypeBase::~CFGEdgeTypeBase() 
 {
 }
 
-std::string CFGEdgeTypeBase::GetDotStyle() const
+std::string CFGEdgeTypeBase::GetDotStyle(bool is_back_edge) const
 {
-	if(m_is_back_edge)
+	if(is_back_edge)
 	{
 		// This is a back edge, make it a dashed line.
 		return "dashed";
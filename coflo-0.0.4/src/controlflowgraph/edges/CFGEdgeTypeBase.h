@@ -22,14 +22,52 @@
 
 #include <string>
 #include "coflo_exceptions.hpp"
+#include "../../safe_enum.h"
+
+/**
+ * @class CFGEdgeKind
+ *
+ * The kind of a control flow graph edge.  This is what the CFG stores for each edge; the
+ * CFGEdgeTypeBase-derived classes describe how each kind is presented.
+ *
+ * Definitions:
+ *  - fallthrough\n
+ *    Control simply falls through to the next statement.
+ *  - if_true, if_false\n
+ *    The true and false branches out of an If.
+ *  - jump\n
+ *    A goto.
+ *  - function_call\n
+ *    From a FunctionCallResolved to the called Function's ENTRY.
+ *  - function_return\n
+ *    From a called Function's EXIT back to the statement after the FunctionCallResolved.
+ *  - function_call_bypass\n
+ *    From a FunctionCallResolved directly to the statement after it.
+ *  - impossible\n
+ *    An edge which can never be taken.  See CFGEdgeTypeImpossible.
+ *  - exceptional\n
+ *    An edge taken only when an exception is thrown.
+ */
+DECLARE_ENUM_CLASS(CFGEdgeKind, fallthrough, if_true, if_false, jump, function_call, function_return,
+				   function_call_bypass, impossible, exceptional)
 
 /**
  * Base class for control flow graph edge types.
+ *
+ * Edge types are stateless.  There is one shared instance of each, which GetEdgeType() returns.
  */
 class CFGEdgeTypeBase
 {
 
 public:
+	/**
+	 * Return the edge type object which describes edges of kind @a kind.
+	 *
+	 * @param kind The kind of edge.
+	 * @return Reference to the shared CFGEdgeTypeBase-derived object for @a kind.
+	 */
+	static const CFGEdgeTypeBase& GetEdgeType(CFGEdgeKind kind);
+
 	CFGEdgeTypeBase();
 	/**
 	 *  Copy constructor.
@@ -43,26 +81,9 @@ public:
 	 */
 	virtual ~CFGEdgeTypeBase() = 0;
 	
-	/**
-	 * Mark the edge as a back edge.  We keep this info around because we need it
-	 * for doing certain operations such as topological sorting, and for efficiency
-	 * reasons - both design and run-rime - we want to just determine this once.
-	 * 
-     * @param is_back_edge true if the edge has been determined to be a back edge.
-     */
-	void MarkAsBackEdge(bool is_back_edge) { m_is_back_edge = is_back_edge; };
-	
 	/// @name Informational Predicates
 	//@{
 
-	/**
-	 * Indicates if this is a back edge in the control flow graph, as would be
-	 * caused by a loop.
-	 * 
-     * @return true if this is a back edge, false if it isn't.
-     */
-	bool IsBackEdge() const { return m_is_back_edge; };
-	
 	/**
 	 * Indicates whether this is a normal (as opposed to an Exceptional or Impossible) edge.
 	 *
@@ -106,14 +127,10 @@ public:
 	/**
 	 * Returns a string suitable for use in a Dot "style=" edge attribute.
 	 * 
+	 * @param is_back_edge true if the edge being drawn is a back edge.
      * @return 
      */
-	std::string GetDotStyle() const;
-
-private:
-	
-	/// Flag indicating whether this edge has been determined to be a back edge or not.
-	bool m_is_back_edge;
+	std::string GetDotStyle(bool is_back_edge) const;
 
 };
 
@@ -17,18 +17,15 @@
 
 #include "CFGEdgeTypeFunctionCall.h"
 
-CFGEdgeTypeFunctionCall::CFGEdgeTypeFunctionCall(FunctionCallResolved *function_call) : CFGEdgeTypeBase()
+CFGEdgeTypeFunctionCall::CFGEdgeTypeFunctionCall() : CFGEdgeTypeBase()
 {
-	m_function_call = function_call;
 }
 
 CFGEdgeTypeFunctionCall::CFGEdgeTypeFunctionCall(const CFGEdgeTypeFunctionCall& orig) : CFGEdgeTypeBase(orig)
 {
-	m_function_call = orig.m_function_call;
 }
 
 CFGEdgeTypeFunctionCall::~CFGEdgeTypeFunctionCall()
 {
-	// Nothing to destroy.  We don't own the m_function_call.
 }
 
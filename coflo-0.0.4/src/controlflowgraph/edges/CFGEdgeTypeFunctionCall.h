@@ -22,24 +22,18 @@
 
 #include "CFGEdgeTypeBase.h"
 
-class FunctionCallResolved;
-
 /**
  * A function call edge.
- * 
- * @param function_call
+ *
+ * The FunctionCallResolved which resulted in the edge is kept by the ControlFlowGraph,
+ * see ControlFlowGraph::GetEdgeFunctionCall().
  */
 class CFGEdgeTypeFunctionCall : public CFGEdgeTypeBase
 {
 public:
-	CFGEdgeTypeFunctionCall(FunctionCallResolved *function_call);
+	CFGEdgeTypeFunctionCall();
 	CFGEdgeTypeFunctionCall(const CFGEdgeTypeFunctionCall& orig);
 	virtual ~CFGEdgeTypeFunctionCall();
-	
-//private:
-	/// The FunctionCall instance which resulted in this edge.
-	/// We need this to determine e.g. what parameters were passed.
-	FunctionCallResolved *m_function_call;
 };
 
 #endif	/* CFGEDGETYPEFUNCTIONCALL_H */
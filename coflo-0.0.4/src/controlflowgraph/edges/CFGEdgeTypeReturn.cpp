@@ -17,14 +17,12 @@
 
 #include "CFGEdgeTypeReturn.h"
 
-CFGEdgeTypeReturn::CFGEdgeTypeReturn(FunctionCallResolved *function_call)
+CFGEdgeTypeReturn::CFGEdgeTypeReturn()
 {
-	m_function_call = function_call;
 }
 
 CFGEdgeTypeReturn::CFGEdgeTypeReturn(const CFGEdgeTypeReturn& orig) : CFGEdgeTypeBase(orig)
 {
-	m_function_call = orig.m_function_call;
 }
 
 CFGEdgeTypeReturn::~CFGEdgeTypeReturn()
@@ -20,23 +20,20 @@
 
 #include "CFGEdgeTypeBase.h"
 
-class FunctionCallResolved;
-
+/**
+ * A function return edge.
+ *
+ * The FunctionCallResolved which resulted in the edge, which we need to determine the point to
+ * return to, is kept by the ControlFlowGraph.  See ControlFlowGraph::GetEdgeFunctionCall().
+ */
 class CFGEdgeTypeReturn : public CFGEdgeTypeBase
 {
 public:
-	CFGEdgeTypeReturn(FunctionCallResolved *function_call);
+	CFGEdgeTypeReturn();
 	CFGEdgeTypeReturn(const CFGEdgeTypeReturn& orig);
 	virtual ~CFGEdgeTypeReturn();
 	
 	virtual std::string GetDotLabel() const { return "Return"; };
-
-//private:
-	
-	/// The FunctionCallResolved statement which resulted in this edge.
-	/// We need this to determine the point to return to.
-	FunctionCallResolved *m_function_call;
-
 };
 
 #endif	/* CFGEDGETYPERETURN_H */
@@ -21,6 +21,7 @@
 
 AssignmentBase::AssignmentBase()
 {
+	SetStatementKind(STATEMENT_KIND);
 	// TODO Auto-generated constructor stub
 
 }
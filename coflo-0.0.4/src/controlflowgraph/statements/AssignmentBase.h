@@ -28,6 +28,8 @@
 class AssignmentBase: public StatementBase
 {
 public:
+	static const T_STATEMENT_KIND STATEMENT_KIND = StatementBase::STATEMENT_KIND | SK_ASSIGNMENT_BASE;
+
 	AssignmentBase();
 	virtual ~AssignmentBase();
 };
@@ -19,10 +19,12 @@
 
 Entry::Entry(const Location &location) : PseudoStatement (location)
 {
+	SetStatementKind(STATEMENT_KIND);
 }
 
 Entry::Entry(const Entry& orig) : PseudoStatement(orig)
 {
+	SetStatementKind(STATEMENT_KIND);
 }
 
 Entry::~Entry()
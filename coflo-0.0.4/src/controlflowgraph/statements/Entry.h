@@ -24,6 +24,8 @@ class Entry : public PseudoStatement
 {
 
 public:
+	static const T_STATEMENT_KIND STATEMENT_KIND = PseudoStatement::STATEMENT_KIND | SK_ENTRY;
+
 	Entry(const Location &location);
 	Entry(const Entry& orig);
 	virtual ~Entry();
@@ -19,10 +19,12 @@
 
 Exit::Exit(const Location &location) : PseudoStatement (location)
 {
+	SetStatementKind(STATEMENT_KIND);
 }
 
 Exit::Exit(const Exit& orig) : PseudoStatement(orig)
 {
+	SetStatementKind(STATEMENT_KIND);
 }
 
 Exit::~Exit()
@@ -23,6 +23,8 @@
 class Exit : public PseudoStatement
 {
 public:
+	static const T_STATEMENT_KIND STATEMENT_KIND = PseudoStatement::STATEMENT_KIND | SK_EXIT;
+
 	Exit(const Location &location);
 	Exit(const Exit& orig);
 	virtual ~Exit();
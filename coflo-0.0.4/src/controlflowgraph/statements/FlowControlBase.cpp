@@ -21,11 +21,13 @@
 
 FlowControlBase::FlowControlBase(const Location &location) : StatementBase(location)
 {
+	SetStatementKind(STATEMENT_KIND);
 
 }
 
 FlowControlBase::FlowControlBase(const FlowControlBase& orig) : StatementBase(orig)
 {
+	SetStatementKind(STATEMENT_KIND);
 
 }
 
@@ -28,6 +28,8 @@
 class FlowControlBase: public StatementBase
 {
 public:
+	static const T_STATEMENT_KIND STATEMENT_KIND = StatementBase::STATEMENT_KIND | SK_FLOW_CONTROL_BASE;
+
 	FlowControlBase(const Location &location);
 	FlowControlBase(const FlowControlBase& orig);
 	virtual ~FlowControlBase();
@@ -20,11 +20,13 @@
 
 FunctionCall::FunctionCall(const Location &location, const std::string &params) : StatementBase(location)
 {
+	SetStatementKind(STATEMENT_KIND);
 	m_params = params;
 }
 
 FunctionCall::FunctionCall(const FunctionCall& orig) : StatementBase(orig)
 {
+	SetStatementKind(STATEMENT_KIND);
 	m_params = orig.m_params;
 }
 
@@ -31,6 +31,8 @@ class Location;
 class FunctionCall : public StatementBase
 {
 public:
+	static const T_STATEMENT_KIND STATEMENT_KIND = StatementBase::STATEMENT_KIND | SK_FUNCTION_CALL;
+
 	FunctionCall(const Location &location, const std::string &params);
 	FunctionCall(const FunctionCall& orig);
 	virtual ~FunctionCall();
@@ -40,13 +42,6 @@ public:
 	
 	virtual std::string GetIdentifierCFG() const;
 
-	/**
-	 * Anything derived from this class is a function call of some sort.
-	 *
-	 * @return true, indicating this is a function call.
-	 */
-	virtual bool IsFunctionCall() const { return true; };
-
 	/// The parameters passed to the function.
 	/// @todo We need to handle this better in many ways.
 	std::string m_params;
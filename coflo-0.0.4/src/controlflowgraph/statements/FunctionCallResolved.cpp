@@ -24,11 +24,13 @@
 
 FunctionCallResolved::FunctionCallResolved(Function *f, FunctionCallUnresolved *fcu) : FunctionCall(fcu->GetLocation(), fcu->m_params)
 {
+	SetStatementKind(STATEMENT_KIND);
 	m_target_function = f;
 }
 
 FunctionCallResolved::FunctionCallResolved(const FunctionCallResolved& orig) : FunctionCall(orig)
 {
+	SetStatementKind(STATEMENT_KIND);
 	m_target_function = orig.m_target_function;
 }
 
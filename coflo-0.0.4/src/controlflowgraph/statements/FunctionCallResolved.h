@@ -30,6 +30,8 @@ class FunctionCallResolved : public FunctionCall
 {
 
 public:
+	static const T_STATEMENT_KIND STATEMENT_KIND = FunctionCall::STATEMENT_KIND | SK_FUNCTION_CALL_RESOLVED;
+
 	FunctionCallResolved(Function *target_function, FunctionCallUnresolved *fcu);
 	FunctionCallResolved(const FunctionCallResolved& orig);
 	virtual ~FunctionCallResolved();
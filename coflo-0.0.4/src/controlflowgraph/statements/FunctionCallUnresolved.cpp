@@ -20,11 +20,13 @@
 FunctionCallUnresolved::FunctionCallUnresolved(std::string identifier, const Location &location, const std::string &params)
 	: FunctionCall(location, params)
 {
+	SetStatementKind(STATEMENT_KIND);
 	m_identifier = identifier;
 }
 
 FunctionCallUnresolved::FunctionCallUnresolved(const FunctionCallUnresolved& orig) : FunctionCall(orig)
 {
+	SetStatementKind(STATEMENT_KIND);
 	m_identifier = orig.m_identifier;
 }
 
@@ -24,6 +24,8 @@ class FunctionCallUnresolved : public FunctionCall
 {
 
 public:
+	static const T_STATEMENT_KIND STATEMENT_KIND = FunctionCall::STATEMENT_KIND | SK_FUNCTION_CALL_UNRESOLVED;
+
 	FunctionCallUnresolved(std::string identifier, const Location &location, const std::string &params);
 	FunctionCallUnresolved(const FunctionCallUnresolved& orig);
 	virtual ~FunctionCallUnresolved();
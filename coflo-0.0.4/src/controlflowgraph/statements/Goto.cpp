@@ -21,11 +21,13 @@
 
 Goto::Goto(const Location &location) : FlowControlBase(location)
 {
+	SetStatementKind(STATEMENT_KIND);
 
 }
 
 Goto::Goto(const Goto& orig) : FlowControlBase(orig)
 {
+	SetStatementKind(STATEMENT_KIND);
 
 }
 
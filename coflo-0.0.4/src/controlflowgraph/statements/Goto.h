@@ -28,6 +28,8 @@
 class Goto: public FlowControlBase
 {
 public:
+	static const T_STATEMENT_KIND STATEMENT_KIND = FlowControlBase::STATEMENT_KIND | SK_GOTO;
+
 	Goto(const Location &location);
 	Goto(const Goto& orig);
 	virtual ~Goto();
@@ -19,11 +19,13 @@
 
 If::If(const Location &location, const std::string &condition) : FlowControlBase(location)
 {
+	SetStatementKind(STATEMENT_KIND);
 	m_condition = condition;
 }
 
 If::If(const If& orig) : FlowControlBase(orig)
 {
+	SetStatementKind(STATEMENT_KIND);
 }
 
 If::~ If() 
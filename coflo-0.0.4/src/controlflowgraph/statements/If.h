@@ -30,6 +30,8 @@
 class If : public FlowControlBase
 {
 public:
+	static const T_STATEMENT_KIND STATEMENT_KIND = FlowControlBase::STATEMENT_KIND | SK_IF | SK_DECISION;
+
 	If(const Location &location, const std::string &condition);
 	If(const If& orig);
 	virtual ~If();
@@ -39,8 +41,6 @@ public:
 	virtual std::string GetIdentifierCFG() const { return "if(" + m_condition + ")"; };
 	
 	virtual std::string GetShapeTextDOT() const { return "diamond"; };
-	
-	virtual bool IsDecisionStatement() const { return true; };
 
 private:
 
@@ -21,12 +21,14 @@
 
 Label::Label(const Location &location, const std::string &identifier) : PseudoStatement(location)
 {
+	SetStatementKind(STATEMENT_KIND);
 	m_identifier = identifier;
 
 }
 
 Label::Label(const Label& orig) : PseudoStatement(orig)
 {
+	SetStatementKind(STATEMENT_KIND);
 	m_identifier = orig.m_identifier;
 }
 
@@ -28,6 +28,8 @@
 class Label: public PseudoStatement
 {
 public:
+	static const T_STATEMENT_KIND STATEMENT_KIND = PseudoStatement::STATEMENT_KIND | SK_LABEL;
+
 	Label(const Location &location, const std::string &identifier);
 	Label(const Label& orig);
 	virtual ~Label();
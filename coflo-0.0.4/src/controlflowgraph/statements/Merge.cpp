@@ -21,12 +21,14 @@
 
 Merge::Merge(const Location &location) : PseudoStatement(location)
 {
+	SetStatementKind(STATEMENT_KIND);
 	// TODO Auto-generated constructor stub
 
 }
 
 Merge::Merge(const Merge &orig) : PseudoStatement(orig)
 {
+	SetStatementKind(STATEMENT_KIND);
 	// TODO Auto-generated destructor stub
 }
 
@@ -28,6 +28,8 @@
 class Merge: public PseudoStatement
 {
 public:
+	static const T_STATEMENT_KIND STATEMENT_KIND = PseudoStatement::STATEMENT_KIND | SK_MERGE;
+
 	Merge(const Location &location);
 	Merge(const Merge &orig);
 	virtual ~Merge();
@@ -21,10 +21,12 @@
 
 NoOp::NoOp(const Location &location) : PseudoStatement (location)
 {
+	SetStatementKind(STATEMENT_KIND);
 }
 
 NoOp::NoOp(const NoOp& orig) : PseudoStatement(orig)
 {
+	SetStatementKind(STATEMENT_KIND);
 }
 
 NoOp::~ NoOp()
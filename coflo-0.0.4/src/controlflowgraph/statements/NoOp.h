@@ -30,6 +30,8 @@
 class NoOp : public PseudoStatement
 {
 public:
+	static const T_STATEMENT_KIND STATEMENT_KIND = PseudoStatement::STATEMENT_KIND | SK_NO_OP;
+
 	NoOp(const Location &location);
 	NoOp(const NoOp& orig);
 	virtual ~NoOp();
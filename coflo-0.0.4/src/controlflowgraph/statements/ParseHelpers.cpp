@@ -23,7 +23,6 @@
 
 #include "../ControlFlowGraph.h"
 #include "statements.h"
-#include "../edges/edge_types.h"
 
 class LabelMap : public std::map< std::string, T_CFG_VERTEX_DESC>
 {
@@ -45,9 +44,9 @@ FlowControlBase* GotoUnlinked::ResolveLinks(ControlFlowGraph &cfg, T_CFG_VERTEX_
 	else
 	{
 		// Found it.  Add an edge.
-		cfg.AddEdge(this_vertex, (*it).second, new CFGEdgeTypeFallthrough());
+		cfg.AddEdge(this_vertex, (*it).second, CFGEdgeKind::fallthrough);
 
-		return new Goto(this->GetLocation());
+		return cfg.NewStatement<Goto>(this->GetLocation());
 	}
 }
 
@@ -66,10 +65,10 @@ FlowControlBase* ReturnUnlinked::ResolveLinks(ControlFlowGraph &cfg, T_CFG_VERTE
 	else
 	{
 		// Found it.  Add an edge.
-		cfg.AddEdge(this_vertex, (*it).second, new CFGEdgeTypeFallthrough());
+		cfg.AddEdge(this_vertex, (*it).second, CFGEdgeKind::fallthrough);
 
 		/// @todo Create a real Return class, return that instead.
-		return new Goto(this->GetLocation());
+		return cfg.NewStatement<Goto>(this->GetLocation());
 	}
 }
 
@@ -95,10 +94,10 @@ FlowControlBase* IfUnlinked::ResolveLinks(ControlFlowGraph &cfg, T_CFG_VERTEX_DE
 	else
 	{
 		// Found both targets.  Add edges.
-		cfg.AddEdge(this_vertex, (*it_true).second, new CFGEdgeTypeIfTrue());
-		cfg.AddEdge(this_vertex, (*it_false).second, new CFGEdgeTypeIfFalse());
+		cfg.AddEdge(this_vertex, (*it_true).second, CFGEdgeKind::if_true);
+		cfg.AddEdge(this_vertex, (*it_false).second, CFGEdgeKind::if_false);
 
-		return new If(this->GetLocation(), m_condition);
+		return cfg.NewStatement<If>(this->GetLocation(), m_condition);
 	}
 }
 
@@ -136,7 +135,7 @@ FlowControlBase* SwitchUnlinked::ResolveLinks(ControlFlowGraph &cfg, T_CFG_VERTE
 		else
 		{
 			// Found it.  Add an edge.
-			cfg.AddEdge(this_vertex, (*it).second, new CFGEdgeTypeFallthrough());
+			cfg.AddEdge(this_vertex, (*it).second, CFGEdgeKind::fallthrough);
 
 			resolved_any_links = true;
 		}
@@ -144,7 +143,7 @@ FlowControlBase* SwitchUnlinked::ResolveLinks(ControlFlowGraph &cfg, T_CFG_VERTE
 
 	if(resolved_any_links)
 	{
-		return new Switch(this->GetLocation());
+		return cfg.NewStatement<Switch>(this->GetLocation());
 	}
 	else
 	{
@@ -40,8 +40,10 @@ class LabelMap;
 class FlowControlUnlinked : public FlowControlBase
 {
 public:
-	FlowControlUnlinked() : FlowControlBase(Location()) {};
-	FlowControlUnlinked(const Location &loc) : FlowControlBase(loc)	{ };
+	static const T_STATEMENT_KIND STATEMENT_KIND = FlowControlBase::STATEMENT_KIND | SK_FLOW_CONTROL_UNLINKED;
+
+	FlowControlUnlinked() : FlowControlBase(Location()) { SetStatementKind(STATEMENT_KIND); };
+	FlowControlUnlinked(const Location &loc) : FlowControlBase(loc)	{ SetStatementKind(STATEMENT_KIND); };
 	virtual ~FlowControlUnlinked() {};
 
 	/**
@@ -59,11 +61,15 @@ public:
 class GotoUnlinked : public FlowControlUnlinked
 {
 public:
+	static const T_STATEMENT_KIND STATEMENT_KIND = FlowControlUnlinked::STATEMENT_KIND | SK_GOTO_UNLINKED;
+
 	GotoUnlinked() : FlowControlUnlinked(Location())
 	{
+		SetStatementKind(STATEMENT_KIND);
 	}
 	GotoUnlinked(const Location &loc, const std::string &link_target_name) : FlowControlUnlinked(loc)
 	{
+		SetStatementKind(STATEMENT_KIND);
 		m_link_target_name = link_target_name;
 	}
 	virtual ~GotoUnlinked() {};
@@ -82,12 +88,15 @@ private:
 class ReturnUnlinked : public FlowControlUnlinked
 {
 public:
+	static const T_STATEMENT_KIND STATEMENT_KIND = FlowControlUnlinked::STATEMENT_KIND | SK_RETURN_UNLINKED;
+
 	ReturnUnlinked() : FlowControlUnlinked(Location())
 	{
-
+		SetStatementKind(STATEMENT_KIND);
 	}
 	ReturnUnlinked(const Location &loc, const std::string &return_var_name) : FlowControlUnlinked(loc)
 	{
+		SetStatementKind(STATEMENT_KIND);
 		m_return_var_name = return_var_name;
 	}
 	virtual ~ReturnUnlinked() {};
@@ -104,10 +113,13 @@ private:
 class IfUnlinked : public FlowControlUnlinked
 {
 public:
-	IfUnlinked() : FlowControlUnlinked() {};
+	static const T_STATEMENT_KIND STATEMENT_KIND = FlowControlUnlinked::STATEMENT_KIND | SK_IF_UNLINKED;
+
+	IfUnlinked() : FlowControlUnlinked() { SetStatementKind(STATEMENT_KIND); };
 	IfUnlinked(const Location &loc, const std::string &condition,
 			GotoUnlinked *goto_true, GotoUnlinked *goto_false) : FlowControlUnlinked(loc)
 	{
+		SetStatementKind(STATEMENT_KIND);
 		m_condition = condition;
 		m_true = goto_true;
 		m_false = goto_false;
@@ -127,9 +139,12 @@ private:
 class CaseUnlinked : public FlowControlUnlinked
 {
 public:
-	CaseUnlinked() : FlowControlUnlinked(Location()) {};
+	static const T_STATEMENT_KIND STATEMENT_KIND = FlowControlUnlinked::STATEMENT_KIND | SK_CASE_UNLINKED;
+
+	CaseUnlinked() : FlowControlUnlinked(Location()) { SetStatementKind(STATEMENT_KIND); };
 	CaseUnlinked(const Location &loc, /* condition,*/ const std::string &link_target_name) : FlowControlUnlinked(loc)
 	{
+		SetStatementKind(STATEMENT_KIND);
 		m_link_target_name = link_target_name;
 	}
 	virtual ~CaseUnlinked() {};
@@ -147,8 +162,10 @@ private:
 class SwitchUnlinked : public FlowControlUnlinked
 {
 public:
-	SwitchUnlinked() : FlowControlUnlinked(Location()) {};
-	SwitchUnlinked(const Location &loc) : FlowControlUnlinked(loc) {};
+	static const T_STATEMENT_KIND STATEMENT_KIND = FlowControlUnlinked::STATEMENT_KIND | SK_SWITCH_UNLINKED;
+
+	SwitchUnlinked() : FlowControlUnlinked(Location()) { SetStatementKind(STATEMENT_KIND); };
+	SwitchUnlinked(const Location &loc) : FlowControlUnlinked(loc) { SetStatementKind(STATEMENT_KIND); };
 	virtual ~SwitchUnlinked() {};
 
 	void InsertCase(CaseUnlinked *the_case)
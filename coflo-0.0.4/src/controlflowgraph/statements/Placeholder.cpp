@@ -21,12 +21,14 @@
 
 Placeholder::Placeholder(const Location &location) : PseudoStatement (location)
 {
+	SetStatementKind(STATEMENT_KIND);
 	// TODO Auto-generated constructor stub
 
 }
 
 Placeholder::Placeholder(const Placeholder & other) : PseudoStatement (other)
 {
+	SetStatementKind(STATEMENT_KIND);
 }
 
 Placeholder::~Placeholder()
@@ -25,6 +25,8 @@
 class Placeholder: public PseudoStatement
 {
 public:
+	static const T_STATEMENT_KIND STATEMENT_KIND = PseudoStatement::STATEMENT_KIND | SK_PLACEHOLDER;
+
 	Placeholder(const Location &location);
 	Placeholder(const Placeholder &other);
 	virtual ~Placeholder();
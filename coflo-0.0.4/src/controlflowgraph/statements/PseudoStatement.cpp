@@ -19,10 +19,12 @@
 
 PseudoStatement::PseudoStatement(const Location &location) : StatementBase(location)
 {
+	SetStatementKind(STATEMENT_KIND);
 }
 
 PseudoStatement::PseudoStatement(const PseudoStatement& orig) : StatementBase(orig)
 {
+	SetStatementKind(STATEMENT_KIND);
 }
 
 PseudoStatement::~PseudoStatement()
@@ -26,6 +26,8 @@
 class PseudoStatement : public StatementBase
 {
 public:
+	static const T_STATEMENT_KIND STATEMENT_KIND = StatementBase::STATEMENT_KIND | SK_PSEUDO_STATEMENT;
+
 	PseudoStatement(const Location &location);
 	PseudoStatement(const PseudoStatement& orig);
 	virtual ~PseudoStatement();
@@ -24,11 +24,11 @@
 #include "FunctionCallUnresolved.h"
 #include "../../Location.h"
 
-StatementBase::StatementBase(const Location &location) : m_location(location)
+StatementBase::StatementBase(const Location &location) : m_location(location), m_statement_kind(STATEMENT_KIND)
 {
 }
 
-StatementBase::StatementBase(const StatementBase& orig)  : m_location(orig.m_location)
+StatementBase::StatementBase(const StatementBase& orig)  : m_location(orig.m_location), m_statement_kind(orig.m_statement_kind)
 {
 	// Do a deep copy of the Location object.
 }
@@ -31,7 +31,56 @@
 class StatementBase
 {
 public:
-	StatementBase() {};
+
+	/**
+	 * The flags which make up a statement's kind.
+	 *
+	 * Every statement carries the flag of its own class and the flags of all the classes it derives
+	 * from, plus any of the categories which cut across the class hierarchy.  Each class's full set is
+	 * its STATEMENT_KIND constant, which its constructors record with SetStatementKind().  Asking what
+	 * a statement is then costs a single mask test rather than a dynamic_cast.
+	 */
+	enum StatementKindFlag
+	{
+		/// @name Categories.
+		//@{
+		/// A decision statement, e.g. an if() or a switch(), which will naturally have more than one out edge.
+		SK_DECISION = 1 << 0,
+		//@}
+
+		/// @name One flag per class.
+		//@{
+		SK_ASSIGNMENT_BASE = 1 << 1,
+		SK_PSEUDO_STATEMENT = 1 << 2,
+		SK_ENTRY = 1 << 3,
+		SK_EXIT = 1 << 4,
+		SK_LABEL = 1 << 5,
+		SK_MERGE = 1 << 6,
+		SK_NO_OP = 1 << 7,
+		SK_PLACEHOLDER = 1 << 8,
+		SK_FLOW_CONTROL_BASE = 1 << 9,
+		SK_GOTO = 1 << 10,
+		SK_IF = 1 << 11,
+		SK_SWITCH = 1 << 12,
+		SK_FUNCTION_CALL = 1 << 13,
+		SK_FUNCTION_CALL_RESOLVED = 1 << 14,
+		SK_FUNCTION_CALL_UNRESOLVED = 1 << 15,
+		SK_FLOW_CONTROL_UNLINKED = 1 << 16,
+		SK_GOTO_UNLINKED = 1 << 17,
+		SK_RETURN_UNLINKED = 1 << 18,
+		SK_IF_UNLINKED = 1 << 19,
+		SK_CASE_UNLINKED = 1 << 20,
+		SK_SWITCH_UNLINKED = 1 << 21
+		//@}
+	};
+
+	/// Type of a statement's kind, a bitwise OR of StatementKindFlags.
+	typedef unsigned long T_STATEMENT_KIND;
+
+	/// The kind of a plain StatementBase.  Every derived class defines its own, adding its flag to its base class's.
+	static const T_STATEMENT_KIND STATEMENT_KIND = 0;
+
+	StatementBase() : m_statement_kind(STATEMENT_KIND) {};
 	StatementBase(const Location &location);
 	StatementBase(const StatementBase& orig);
 	virtual ~StatementBase();
@@ -70,30 +119,36 @@ public:
 	 * 
      * @return The Location of the StatementBase.
      */
-	const Location GetLocation() const { return m_location; };
+	const Location& GetLocation() const { return m_location; };
 
 	
 	/// @name Functions for returning info about the statement.
 	//@{
 
+	/**
+	 * Returns the statement's kind, a bitwise OR of StatementKindFlags.
+	 */
+	T_STATEMENT_KIND GetStatementKind() const { return m_statement_kind; };
+
 	/**
 	 * Is this statement a decision statement, e.g. an if() or a switch(), which will
 	 * naturally have more than one out edge?
 	 *
 	 * @return true if this StatementBase is a decision statement.
 	 */
-	virtual bool IsDecisionStatement() const { return false; };
+	bool IsDecisionStatement() const { return (m_statement_kind & SK_DECISION) != 0; };
 
 	/**
 	 * Is this statement a function call, either resolved or unresolved?
 	 *
 	 * @return true if the statement is a function call, false if it isn't.
 	 */
-	virtual bool IsFunctionCall() const { return false; };
+	bool IsFunctionCall() const { return (m_statement_kind & SK_FUNCTION_CALL) != 0; };
 
 	/**
 	 * When called like "IsType<SomeDerivedType>()", returns whether it's dynamic_castable to
-	 * that type or not.
+	 * that type or not.  This is a constant-time test of the statement's kind, so once it returns
+	 * true it's safe to static_cast to SomeDerivedType.
 	 *
 	 * @deprecated This is one step removed from switch/case.  At the moment this exists for the
 	 * benefit of function_control_flow_graph_visitor, but there's got to be a better way to do it.
@@ -101,7 +156,7 @@ public:
 	 * @return
 	 */
 	template<typename DerivedType>
-	bool IsType() const { return NULL != dynamic_cast<const DerivedType*>(this); };
+	bool IsType() const { return (m_statement_kind & DerivedType::STATEMENT_KIND) == DerivedType::STATEMENT_KIND; };
 
 	//@}
 
@@ -114,10 +169,23 @@ public:
 	 */
 	static std::string EscapeifyForUseInDotLabel(const std::string &str);
 
+protected:
+
+	/**
+	 * Record the statement's kind.  Every constructor of every derived class calls this with
+	 * its class's STATEMENT_KIND, so once construction is complete the most-derived class's wins.
+	 *
+	 * @param statement_kind The new kind.
+	 */
+	void SetStatementKind(T_STATEMENT_KIND statement_kind) { m_statement_kind = statement_kind; };
+
 private:
 
 	/// The Location of this statement.
 	Location m_location;
+
+	/// The statement's kind.  See StatementKindFlag.
+	T_STATEMENT_KIND m_statement_kind;
 };
 
 #endif	/* STATEMENTBASE_H */
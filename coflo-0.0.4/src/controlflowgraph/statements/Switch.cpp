@@ -19,10 +19,12 @@
 
 Switch::Switch(const Location &location) : FlowControlBase(location)
 {
+	SetStatementKind(STATEMENT_KIND);
 }
 
 Switch::Switch(const Switch& orig) : FlowControlBase(orig)
 {
+	SetStatementKind(STATEMENT_KIND);
 }
 
 Switch::~Switch()
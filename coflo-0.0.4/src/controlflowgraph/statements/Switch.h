@@ -23,6 +23,8 @@
 class Switch : public FlowControlBase
 {
 public:
+	static const T_STATEMENT_KIND STATEMENT_KIND = FlowControlBase::STATEMENT_KIND | SK_SWITCH | SK_DECISION;
+
 	Switch(const Location &location);
 	Switch(const Switch& orig);
 	virtual ~Switch();
@@ -32,8 +34,6 @@ public:
 	virtual std::string GetIdentifierCFG() const { return "switch()"; };
 	
 	virtual std::string GetShapeTextDOT() const { return "diamond"; };
-	
-	virtual bool IsDecisionStatement() const { return true; };
 
 private:
 
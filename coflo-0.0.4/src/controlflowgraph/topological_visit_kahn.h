@@ -32,7 +32,7 @@
  * Map of vertex descriptors to the remaining in degree value.
  * This is a lazily-evaluated data structure, in that vertices don't have real entries until the first
  * call to either get() or set().  In the case of get(), a never-before-seen vertex will be initialized to
- * a remaining in degree of its real boost::in_degree() (actually filtered_in_degree() at the moment).
+ * a remaining in degree of its filtered_in_degree(), which the graph has precomputed.
  */
 template < typename Graph >
 class RemainingInDegreeMap
@@ -71,7 +71,6 @@ public:
 			// encountered it before now.
 			// Pretend it was in the map and add it with its original in-degree.
 			T_DEGREE_SIZE_TYPE indegree;
-			/// @todo We should find a better way to get this "filtered" in degree value.
 			indegree = filtered_in_degree(vdesc, m_graph);
 			m_remaining_in_degree_map[vdesc] = indegree;
 
@@ -93,6 +92,17 @@ private:
 	T_UNDERLYING_MAP m_remaining_in_degree_map;
 };
 
+/**
+ * Generic fallback for graphs which don't know about basic blocks: no vertex is known to be inside one.
+ * Graphs which do, such as BasicBlockGraph, provide an overload found by argument-dependent lookup.
+ *
+ * @return true if @a v's only in edge is the fallthrough from the previous statement of its basic block.
+ */
+template < typename Graph >
+bool is_basic_block_interior(typename boost::graph_traits<Graph>::vertex_descriptor v, const Graph &graph)
+{
+	return false;
+}
 
 /**
  * Kahn's algorithm for topologically sorting (in this case visiting) the nodes of a graph.
@@ -149,7 +159,7 @@ topological_visit_kahn(BidirectionalGraph &graph,
 		e = no_remaining_in_edges_set.top();
 		no_remaining_in_edges_set.pop();
 
-		u = boost::target(e, graph);
+		u = target(e, graph);
 
 		// Visit vertex u.  Vertices will be visited in the correct (i.e. not reverse-topologically-sorted) order.
 		visitor_vertex_return_value = visitor.discover_vertex(u, e);
@@ -164,7 +174,9 @@ topological_visit_kahn(BidirectionalGraph &graph,
 		//
 
 		// Get iterators to the out edges of vertex u.
-		boost::tie(ei, eend) = boost::out_edges(u, graph);
+		// Call out_edges() and target() unqualified, so that argument-dependent lookup can find the
+		// overloads for graph types outside of the Boost namespace, such as ControlFlowGraphSnapshot.
+		boost::tie(ei, eend) = out_edges(u, graph);
 		T_EDGE_DESC first_edge_pushed;
 
 		while (ei != eend)
@@ -192,19 +204,28 @@ topological_visit_kahn(BidirectionalGraph &graph,
 			}
 
 			// Get the target vertex of this edge.
-			v = boost::target(*ei, graph);
+			v = target(*ei, graph);
 
-			// Look up the current in-degree of the target vertex of *ei in the
-			// in-degree map.
 			long id;
-			id = in_degree_map.get(v);
+			if(is_basic_block_interior(v, graph))
+			{
+				// *ei is v's only in edge, so removing it always leaves v with an in-degree of zero.
+				// No need to go through the map.
+				id = 0;
+			}
+			else
+			{
+				// Look up the current in-degree of the target vertex of *ei in the
+				// in-degree map.
+				id = in_degree_map.get(v);
 
-			// We're "removing" this edge, so decrement the effective in-degree of
-			// vertex v.
-			--id;
+				// We're "removing" this edge, so decrement the effective in-degree of
+				// vertex v.
+				--id;
 
-			// Store the decremented value back to the map.
-			in_degree_map.set(v, id);
+				// Store the decremented value back to the map.
+				in_degree_map.set(v, id);
+			}
 
 			if (id == 0)
 			{
@@ -65,7 +65,7 @@ public:
 	void tree_edge(T_EDGE_DESC e, const GraphType &g)
 	{
 		// An edge just became part of the DFS search tree.  Capture the predecessor info this provides.
-		m_predecessor_map[boost::target(e, g)] = e;
+		m_predecessor_map[target(e, g)] = e;
 	};
 
 	void back_edge(T_EDGE_DESC e, const GraphType &g)
@@ -81,7 +81,7 @@ public:
 		BackEdgeFixupInfo fui;
 
 		fui.m_back_edge = e;
-		if(boost::source(e,g) == boost::target(e,g))
+		if(source(e,g) == target(e,g))
 		{
 			dlog_cfg << "FOUND BACK EDGE (SELF): " << e << std::endl;
 			fui.m_impossible_target_vertex = boost::graph_traits<GraphType>::null_vertex();
@@ -90,7 +90,7 @@ public:
 		{
 			fui.m_impossible_target_vertex = FindForwardTargetForBackEdge(g, e);
 		}
-		//fui.m_impossible_target_vertex = boost::target(e, g);
+		//fui.m_impossible_target_vertex = target(e, g);
 
 		m_back_edges.push_back(fui);
 	}
@@ -110,7 +110,7 @@ private:
 		T_OUT_EDGE_ITERATOR ei, eend;
 
 		// Get a pair of iterators over the out edges of e's source node.
-		boost::tie(ei, eend) = boost::out_edges(boost::source(e, cfg), cfg);
+		boost::tie(ei, eend) = out_edges(source(e, cfg), cfg);
 
 		for(; ei != eend; ++ei)
 		{
@@ -146,8 +146,8 @@ private:
 		// The forward target we'll try to find.
 		T_VERTEX_DESC retval = boost::graph_traits<GraphType>::null_vertex();
 
-		u = boost::source(e, cfg);
-		v = boost::target(e, cfg);
+		u = source(e, cfg);
+		v = target(e, cfg);
 
 
 		// Walk back up the path by which the DFS got here until we reach the target of the back edge.
@@ -158,7 +158,7 @@ private:
 		{
 			// Get the predecessor of this vertex.
 			e = m_predecessor_map[u];
-			w = boost::source(e, cfg);
+			w = source(e, cfg);
 
 			dlog_cfg << "WALKING PREDECESSOR TREE: VERTEX " << w << std::endl;
 
@@ -172,7 +172,7 @@ private:
 				T_CFG_EDGE_DESC other_edge;
 				other_edge = FindDifferentOutEdge(e, cfg);
 
-				retval = boost::target(other_edge, cfg);
+				retval = target(other_edge, cfg);
 				break;
 			}
 
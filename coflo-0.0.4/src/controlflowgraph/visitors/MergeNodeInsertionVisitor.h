@@ -80,9 +80,9 @@ public:
 
 		dlog_cfg << "FOUND EDGE=" << e << std::endl;
 
-		terminal_target = boost::target(e, g);
+		terminal_target = target(e, g);
 
-		if(terminal_target == boost::source(e, g))
+		if(terminal_target == source(e, g))
 		{
 			// This is a self-edge.
 			return;
@@ -160,12 +160,12 @@ public:
 		T_OUT_EDGE_ITERATOR ei, eend;
 
 		// Get a pair of iterators over the out edges of this node.
-		boost::tie(ei, eend) = boost::out_edges(u, g);
+		boost::tie(ei, eend) = out_edges(u, g);
 
 		for(; ei != eend; ++ei)
 		{
 			T_VERTEX_DESC terminal_target;
-			terminal_target = boost::target(*ei, g);
+			terminal_target = target(*ei, g);
 			if(terminal_target==u)
 			{
 				// This is a self-edge.
@@ -175,14 +175,14 @@ public:
 			StatementBase *sb;
 			sb = g[terminal_target].m_statement;
 
-			if(dynamic_cast<Merge*>(sb) != NULL)
+			if(sb->IsType<Merge>())
 			{
 				// This is already a merge node, don't add another one in front of it.
 				continue;
 			}
 
 			// If the in degree of the target > 1, u is a vertex which ends a branch.
-			long indeg = boost::in_degree(terminal_target, g);//filtered_in_degree(terminal_target, g);
+			long indeg = in_degree(terminal_target, g);//filtered_in_degree(terminal_target, g);
 			if(indeg > 1)
 			{
 				// Ends the branch.
@@ -246,13 +246,13 @@ private:
 	{
 		T_IN_EDGE_ITERATOR ieit, ieend;
 
-		boost::tie(ieit, ieend) = boost::in_edges(v, cfg);
+		boost::tie(ieit, ieend) = in_edges(v, cfg);
 
 		long i = 0;
 		bool saw_function_call_already = false;
 		for (; ieit != ieend; ++ieit)
 		{
-			if (cfg[*ieit].m_edge_type->IsBackEdge())
+			if (cfg[*ieit].m_is_back_edge)
 			{
 				// Always skip anything marked as a back edge.
 				continue;
@@ -265,14 +265,13 @@ private:
 			//   looking at a vertex v that's an ENTRY statement, with a predecessor of type FunctionCallResolved.
 			//   Any particular instance of an ENTRY has at most only one valid FunctionCall edge.
 			//   For our current purposes, we only care about this one.
-			if ((dynamic_cast<CFGEdgeTypeReturn*>(cfg[*ieit].m_edge_type) == NULL)
+			if ((cfg[*ieit].GetEdgeKind() != CFGEdgeKind::function_return)
 					&& (saw_function_call_already == false))
 			{
 				i++;
 			}
 
-			if (dynamic_cast<CFGEdgeTypeFunctionCall*>(cfg[*ieit].m_edge_type)
-					!= NULL)
+			if (cfg[*ieit].GetEdgeKind() == CFGEdgeKind::function_call)
 			{
 				// Multiple incoming function calls only count as one for convergence purposes.
 				saw_function_call_already = true;
@@ -286,18 +285,18 @@ private:
 	{
 		T_OUT_EDGE_ITERATOR eit, eend;
 
-		boost::tie(eit, eend) = boost::out_edges(v, cfg);
+		boost::tie(eit, eend) = out_edges(v, cfg);
 
 		long i = 0;
 		for (; eit != eend; ++eit)
 		{
-			if(v == boost::target(*eit, cfg))
+			if(v == target(*eit, cfg))
 			{
 				// Skip any self edges.
 				continue;
 			}
 
-			if (cfg[*eit].m_edge_type->IsBackEdge())
+			if (cfg[*eit].m_is_back_edge)
 			{
 				// Skip anything marked as a back edge.
 				continue;
@@ -26,8 +26,10 @@
 #include "gcc_gimple_parser.h"
 
 #include "Location.h"
+#include "ParseArena.h"
 #include "controlflowgraph/statements/statements.h"
 #include "controlflowgraph/statements/ParseHelpers.h"
+#include "debug_utils/debug_utils.hpp"
 
 #define D_ParseNode_Globals gcc_gimple_parser_ParseNode_Globals
 #define D_ParseNode_User gcc_gimple_parser_ParseNode_User
@@ -45,16 +47,21 @@ void gcc_gimple_parser_FreeNodeFn(D_ParseNode *d);
 #define M_TO_STR(the_n) std::string(the_n.start_loc.s, the_n.end-the_n.start_loc.s)
 #define M_PROPAGATE_PTR(from, to, field_name) do { to.field_name = from.field_name; from.field_name = NULL; } while(0) 
 
-// The globals.
-static gcc_gimple_parser_ParseNode_Globals TheGlobals;
-
-D_Parser* new_gcc_gimple_Parser()
+D_Parser* new_gcc_gimple_Parser(ParseArena *arena)
 {
 	D_Parser *parser = new_D_Parser(&parser_tables_gcc_gimple_parser, sizeof(D_ParseNode_User));
 	parser->free_node_fn = gcc_gimple_parser_FreeNodeFn;
 	parser->commit_actions_interval = 0;
 	parser->error_recovery = 1;
 	parser->save_parse_tree = 1;
+
+	// Each parser gets its own globals, which the actions get to through $g.  Nothing else
+	// in here is shared between parsers, so separate parsers can be run concurrently.
+	gcc_gimple_parser_ParseNode_Globals *globals = new gcc_gimple_parser_ParseNode_Globals;
+	globals->m_translation_unit = NULL;
+	globals->m_function_info_list = NULL;
+	globals->m_arena = arena;
+	parser->initial_globals = globals;
 	
 	return parser;
 }
@@ -77,7 +84,7 @@ gcc_gimple_parser_ParseNode_User* gcc_gimple_parser_GetUserInfo(D_ParseNode *tre
 
 gcc_gimple_parser_ParseNode_Globals* gcc_gimple_parser_GetGlobalInfo(D_ParseNode *tree)
 {
-	return &TheGlobals;
+	return tree->globals;
 }
 
 void free_gcc_gimple_ParseTreeBelow(D_Parser *parser, D_ParseNode *tree)
@@ -87,6 +94,7 @@ void free_gcc_gimple_ParseTreeBelow(D_Parser *parser, D_ParseNode *tree)
 
 void free_gcc_gimple_Parser(D_Parser *parser)
 {
+	delete parser->initial_globals;
 	free_D_Parser(parser);
 }
 
@@ -124,7 +132,7 @@ gcc_gimple_file
 	} function_definition_list
 		{
 			//std::cout << "DONE" << std::endl;
-			TheGlobals.m_function_info_list = $1.m_function_info_list;
+			$g->m_function_info_list = $1.m_function_info_list;
 			M_PROPAGATE_PTR($1, $$, m_function_info_list);
 		}
 	;
@@ -137,7 +145,7 @@ function_definition_list
 		}
 	| function_definition NL+
 		{
-			$$.m_function_info_list = new FunctionInfoList;
+			$$.m_function_info_list = $g->m_arena->NewFunctionInfoList();
 			$$.m_function_info_list->push_back($0.m_function_info);
 		}
 	;
@@ -150,7 +158,7 @@ function_definition
 			dlog_parse_gimple << "  Location: " << *($5.m_location) << std::endl;
 			dlog_parse_gimple << "  Num Statements: " << $9.m_statement_list->size() << std::endl;
 			StatementListPrint($9.m_statement_list);
-			$$.m_function_info = new FunctionInfo;
+			$$.m_function_info = $g->m_arena->NewFunctionInfo();
 			$$.m_function_info->m_location = $5.m_location;
 			$$.m_function_info->m_identifier = $0.m_str;
 			$$.m_function_info->m_statement_list = $9.m_statement_list;
@@ -160,7 +168,7 @@ function_definition
 		{
 			dlog_parse_gimple << "Found C++ style function definition: " << *($1.m_str) << std::endl;
 			StatementListPrint($13.m_statement_list);
-			$$.m_function_info = new FunctionInfo;
+			$$.m_function_info = $g->m_arena->NewFunctionInfo();
 			$$.m_function_info->m_location = $9.m_location;
 			$$.m_function_info->m_identifier = $1.m_str;
 			$$.m_function_info->m_statement_list = $13.m_statement_list;
@@ -171,14 +179,14 @@ location
 	: real_location
 		{ M_PROPAGATE_PTR($0, $$, m_location); }
 	| /* Nothing */
-		{ $$.m_location = new Location(); }
+		{ $$.m_location = $g->m_arena->NewLocation(Location()); }
 	;
 
 real_location
 	: '[' path ':' integer ':' integer ']'
-		{ $$.m_location = new Location(M_TO_STR($n1), $3.m_int, $5.m_int); }
+		{ $$.m_location = $g->m_arena->NewLocation(Location(M_TO_STR($n1), $3.m_int, $5.m_int)); }
 	| '[' path ':' integer ']'
-		{ $$.m_location = new Location(M_TO_STR($n1), $3.m_int); }
+		{ $$.m_location = $g->m_arena->NewLocation(Location(M_TO_STR($n1), $3.m_int)); }
 	;
 	
 param_decls_list
@@ -189,12 +197,12 @@ param_decls_list
 		}
 	| param_decls
 		{ 
-			$$.m_statement_list = new StatementList;
+			$$.m_statement_list = $g->m_arena->NewStatementList();
 			$$.m_statement_list->push_back(NULL);
 		}
 	| /* Nothing */
 		{
-			$$.m_statement_list = new StatementList;
+			$$.m_statement_list = $g->m_arena->NewStatementList();
 		}
 	;
 	
@@ -233,7 +241,7 @@ statement_list
 		}
 	| statement NL
 		{ 
-			$$.m_statement_list = new StatementList;
+			$$.m_statement_list = $g->m_arena->NewStatementList();
 			$$.m_statement_list->push_back($0.m_statement);
 		}
 	| statement_list scope NL
@@ -247,7 +255,7 @@ statement_list
 		}
 	| /* Nothing */
 		{
-			$$.m_statement_list = new StatementList;
+			$$.m_statement_list = $g->m_arena->NewStatementList();
 		}
 	;
 	
@@ -258,8 +266,8 @@ statement
 	// <location> '// predicted unlikely by continue predictor.'
 	| location comment
 		{
-			std::cout << "Ignoring comment" << std::endl;
-			$$.m_statement = new NoOp(Location());
+			dlog_parse_gimple << "Ignoring comment" << std::endl;
+			$$.m_statement = $g->m_arena->NewStatement<NoOp>(Location());
 		}
 	| statement_possibly_split_across_lines
 		{ M_PROPAGATE_PTR($0, $$, m_statement); }
@@ -290,11 +298,11 @@ statement_one_line
 return_statement
 	: location 'return' var_id
 		{
-			$$.m_statement = new ReturnUnlinked(*($0.m_location), *($2.m_str));
+			$$.m_statement = $g->m_arena->NewStatement<ReturnUnlinked>(*($0.m_location), *($2.m_str));
 		}
 	| location 'return'
 		{
-			$$.m_statement = new ReturnUnlinked(*($0.m_location), "");
+			$$.m_statement = $g->m_arena->NewStatement<ReturnUnlinked>(*($0.m_location), "");
 		}
 	;
 	
@@ -338,39 +346,37 @@ assignment_statement
 
 assignment_statement_internals
 	: lhs '=' rhs bitwise_binary_operator rhs
-		{ $$.m_statement = new Placeholder(Location()); }
+		{ $$.m_statement = $g->m_arena->NewStatement<Placeholder>(Location()); }
 	| nested_lhs '=' cast_expression
-		{ $$.m_statement = new Placeholder(Location()); }
+		{ $$.m_statement = $g->m_arena->NewStatement<Placeholder>(Location()); }
 	| lhs '=' '~' rhs
-		{ $$.m_statement = new Placeholder(Location()); }
+		{ $$.m_statement = $g->m_arena->NewStatement<Placeholder>(Location()); }
 	| lhs '=' '-' rhs
-		{ $$.m_statement = new Placeholder(Location()); }
+		{ $$.m_statement = $g->m_arena->NewStatement<Placeholder>(Location()); }
 	| lhs '=' rhs arithmetic_binary_operator rhs
-		{ $$.m_statement = new Placeholder(Location()); }
+		{ $$.m_statement = $g->m_arena->NewStatement<Placeholder>(Location()); }
 	| lhs '=' '(' decl_spec+ ')' rhs
-		{ $$.m_statement = new Placeholder(Location()); }
+		{ $$.m_statement = $g->m_arena->NewStatement<Placeholder>(Location()); }
 	| lhs '=' function_call
 		{ M_PROPAGATE_PTR($2, $$, m_statement); }
 	| lhs '=' ('MIN_EXPR' | 'MAX_EXPR') '<' argument_expression_list '>'
-		{ $$.m_statement = new Placeholder(Location()); }
+		{ $$.m_statement = $g->m_arena->NewStatement<Placeholder>(Location()); }
 	| lhs '=' real_location 'BIT_FIELD_REF' '<' rhs ',' constant ',' constant '>'
-		{ $$.m_statement = new Placeholder(Location()); }
+		{ $$.m_statement = $g->m_arena->NewStatement<Placeholder>(Location()); }
 	| lhs '=' condition
-		{ $$.m_statement = new Placeholder(Location()); }
+		{ $$.m_statement = $g->m_arena->NewStatement<Placeholder>(Location()); }
 	| nested_lhs '=' rhs
-		{ $$.m_statement = new Placeholder(Location()); }
+		{ $$.m_statement = $g->m_arena->NewStatement<Placeholder>(Location()); }
 	;
 	
 if
 	// The style used in 4.5.3.
 	: location 'if' '(' condition ')' goto_statement ';' 'else' goto_statement ';'
 		{
-			$$.m_str = new M_TO_STR($n3);
-			$$.m_statement = new IfUnlinked(*($0.m_location),
-					*($$.m_str),
+			$$.m_statement = $g->m_arena->NewStatement<IfUnlinked>(*($0.m_location),
+					M_TO_STR($n3),
 					dynamic_cast<GotoUnlinked*>($5.m_statement),
 					dynamic_cast<GotoUnlinked*>($8.m_statement));
-			delete $$.m_str;
 		}
 	;
 	
@@ -422,42 +428,42 @@ comparison_operator
 function_call
 	: location identifier '(' argument_expression_list ')'
 		{
-			$$.m_statement = new FunctionCallUnresolved(M_TO_STR($n1), *($0.m_location), M_TO_STR($n3));
+			$$.m_statement = $g->m_arena->NewStatement<FunctionCallUnresolved>(M_TO_STR($n1), *($0.m_location), M_TO_STR($n3));
 		}
 	| location identifier_ssa '(' argument_expression_list ')'
 		{
 			// This should pretty much always be a function call through a compiler-generated function
 			// pointer.
-			$$.m_statement = new FunctionCallUnresolved(M_TO_STR($n1), *($0.m_location), M_TO_STR($n3));
+			$$.m_statement = $g->m_arena->NewStatement<FunctionCallUnresolved>(M_TO_STR($n1), *($0.m_location), M_TO_STR($n3));
 		}
 	;
 
 goto_statement
 	: location 'goto' synthetic_label_id
 		{
-			$$.m_statement = new GotoUnlinked(*($0.m_location), *($2.m_str));
+			$$.m_statement = $g->m_arena->NewStatement<GotoUnlinked>(*($0.m_location), *($2.m_str));
 		}
 	| location 'goto' identifier
 		{
-			$$.m_statement = new GotoUnlinked(*($0.m_location), *($2.m_str));
+			$$.m_statement = $g->m_arena->NewStatement<GotoUnlinked>(*($0.m_location), *($2.m_str));
 		}
 	;
 	
 label_statement
 	: location synthetic_label_id ':'
 		{
-			$$.m_statement = new Label(*($0.m_location), *($1.m_str));
+			$$.m_statement = $g->m_arena->NewStatement<Label>(*($0.m_location), *($1.m_str));
 		}
 	| location identifier ':'
 		{
-			$$.m_statement = new Label(*($0.m_location), *($1.m_str));
+			$$.m_statement = $g->m_arena->NewStatement<Label>(*($0.m_location), *($1.m_str));
 		}
 	;
 
 switch
 	: location 'switch' '(' var_or_constant ')' switch_case_list
 		{
-			$$.m_statement = new SwitchUnlinked(*($0.m_location));
+			$$.m_statement = $g->m_arena->NewStatement<SwitchUnlinked>(*($0.m_location));
 			$0.m_location = NULL;
 			
 			StatementList::iterator it;
@@ -485,7 +491,7 @@ switch_case_list_453
 		}
 	| case_453
 		{
-			$$.m_statement_list = new StatementList;
+			$$.m_statement_list = $g->m_arena->NewStatementList();
 			$$.m_statement_list->push_back($0.m_statement);
 		}
 	;
@@ -499,11 +505,11 @@ case
 case_453
 	: location 'case' rhs ':' synthetic_label_id
 		{
-			$$.m_statement = new CaseUnlinked(*($0.m_location), *($4.m_str));
+			$$.m_statement = $g->m_arena->NewStatement<CaseUnlinked>(*($0.m_location), *($4.m_str));
 		}
 	| location 'default:' synthetic_label_id
 		{
-			$$.m_statement = new CaseUnlinked(*($0.m_location), *($2.m_str));
+			$$.m_statement = $g->m_arena->NewStatement<CaseUnlinked>(*($0.m_location), *($2.m_str));
 		}
 	;
 
@@ -573,7 +579,7 @@ nested_lhs
 	| location '*' var_id
 		{ M_PROPAGATE_PTR($0, $$, m_location); }
 	| var_id
-		{ $$.m_location = new Location(); }
+		{ $$.m_location = $g->m_arena->NewLocation(Location()); }
 	;
 	
 nested_rhs
@@ -588,9 +594,9 @@ nested_rhs
 	| real_location '&' nested_rhs
 		{ M_PROPAGATE_PTR($0, $$, m_location); }
 	| var_id
-		{ $$.m_location = new Location(); }
+		{ $$.m_location = $g->m_arena->NewLocation(Location()); }
 	| constant
-		{ $$.m_location = new Location(); }
+		{ $$.m_location = $g->m_arena->NewLocation(Location()); }
 	| location string_literal
 		{ M_PROPAGATE_PTR($0, $$, m_location); }
 	| real_location var_id
@@ -614,14 +620,13 @@ var_id
 		{ M_PROPAGATE_PTR($0, $$, m_str); }
 	// gcc 4.5.3 sometimes outputs '<retval>' in returns which return a value.
 	| '<retval>'
-		{ $$.m_str = new std::string("<retval>"); }
+		{ $$.m_str = $g->m_arena->NewString("<retval>"); }
 	;
 	
 synthetic_label_id
 	: '<' identifier_ssa '>'
 		{
-			$$.m_str = new std::string;
-			*($$.m_str) = "<" + *($1.m_str) + ">";
+			$$.m_str = $g->m_arena->NewString("<" + *($1.m_str) + ">");
 			$1.m_str = NULL;
 		}
 	;
@@ -629,7 +634,8 @@ synthetic_label_id
 /// Terminals.
 
 NL: '\n';
-whitespace: "[ \t]+";
+// CR's from CRLF line endings are just more whitespace.
+whitespace: "[ \t\r]+";
 integer : "[0-9]+" { $$.m_int = atoi(M_TO_STR($n0).c_str()); } ;
 integer_decimal: "[\-\+]?[1-9][0-9]*" | '0';
 integer_hex: "0x[0-9A-Fa-f]+";
@@ -638,10 +644,10 @@ string_literal: "\"([^\"\\]|\\[^])*\"";
 path: "[a-zA-Z0-9_\.\-\\\/]+" $term -1;
 identifier_ssa
 	: "[a-zA-Z_][a-zA-Z0-9_]*.[0-9]+" $term -2
-		{ $$.m_str = new M_TO_STR($n0); }
+		{ $$.m_str = $g->m_arena->NewString(M_TO_STR($n0)); }
 	;
 identifier
 	: "[a-zA-Z_][a-zA-Z0-9_]*" $term -3
-		{ $$.m_str = new M_TO_STR($n0); }
+		{ $$.m_str = $g->m_arena->NewString(M_TO_STR($n0)); }
 	;
 comment: "\/\/[^\n]+";
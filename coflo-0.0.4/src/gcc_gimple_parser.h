@@ -27,6 +27,7 @@ struct D_Parser;
 
 // Forward declarations for the User data.
 class Location;
+class ParseArena;
 class StatementBase;
 class TranslationUnit;
 
@@ -43,10 +44,13 @@ struct FunctionInfo
 
 typedef std::vector< FunctionInfo* > FunctionInfoList;
 
+/// Type of the per-parser global state, reachable as $g in the grammar actions.
 struct gcc_gimple_parser_ParseNode_Globals
 {
 	TranslationUnit *m_translation_unit;
 	FunctionInfoList *m_function_info_list;
+	/// Owner of all the strings, Locations and lists the grammar actions create.
+	ParseArena *m_arena;
 };
 /// Type of the object that gets passed through the parse tree.
 struct gcc_gimple_parser_ParseNode_User
@@ -61,10 +65,17 @@ struct gcc_gimple_parser_ParseNode_User
 	FunctionInfoList *m_function_info_list;
 };
 
-D_Parser* new_gcc_gimple_Parser();
+/**
+ * Create a new GIMPLE parser.
+ *
+ * @param arena The arena the parser's actions are to allocate from.  It owns everything in the
+ *        FunctionInfos the parse produces, so it has to outlive them.
+ */
+D_Parser* new_gcc_gimple_Parser(ParseArena *arena);
 D_ParseNode* gcc_gimple_dparse(D_Parser *parser, char* buffer, long length);
 long gcc_gimple_parser_GetSyntaxErrorCount(D_Parser *parser);
 gcc_gimple_parser_ParseNode_User* gcc_gimple_parser_GetUserInfo(D_ParseNode *tree);
+/// Returns the globals of the parser which produced @a tree.  Valid until that parser is freed.
 gcc_gimple_parser_ParseNode_Globals* gcc_gimple_parser_GetGlobalInfo(D_ParseNode *tree);
 void free_gcc_gimple_ParseTreeBelow(D_Parser *parser, D_ParseNode *tree);
 void free_gcc_gimple_Parser(D_Parser *parser);
@@ -50,9 +50,10 @@ bool ToolBase::Popen(const std::string &params, std::ostream &progs_stdout) cons
 {
 	FILE *progs_stdout_fp;
 	int status;
-	// Arbitrarily picked a buffer size for fread()'s.
-	const size_t buff_size = 256;
-	unsigned char read_buffer[buff_size];
+	// Big enough that streaming a large compiler dump through here doesn't take an excessive
+	// number of fread()'s.
+	const size_t buff_size = 16*1024;
+	char read_buffer[buff_size];
 	size_t bytes_read;
 	
 	// Run the command in the specified working directory.
@@ -68,7 +69,7 @@ bool ToolBase::Popen(const std::string &params, std::ostream &progs_stdout) cons
 	// Read the text we got from the popen()'ed process and stream it to progs_stdout.
 	while (bytes_read = fread(read_buffer, 1, buff_size, progs_stdout_fp), bytes_read > 0)
 	{
-		progs_stdout << std::string(reinterpret_cast<char*>(&(read_buffer[0])), bytes_read);
+		progs_stdout.write(read_buffer, bytes_read);
 	}
 	
 	// Close the popen()'ed file pointer.
@@ -157,7 +158,8 @@ std::string ToolBase::Mktemp(const std::string &filename_template, bool director
 		// Create a directory.
 		if(mkdtemp(c_template) == NULL)
 		{
-			/// @todo Handle error.
+			std::cerr << "ERROR: Couldn't create temporary directory \"" << filename_template << "\"." << std::endl;
+			c_template[0] = '\0';
 		}
 	}
 	else
@@ -167,9 +169,13 @@ std::string ToolBase::Mktemp(const std::string &filename_template, bool director
 		fd = mkstemp(c_template);
 		if(fd == -1)
 		{
-			/// @todo Handle error.
+			std::cerr << "ERROR: Couldn't create temporary file \"" << filename_template << "\"." << std::endl;
+			c_template[0] = '\0';
+		}
+		else
+		{
+			close(fd);
 		}
-		close(fd);
 	}
 	
 	// Copy the newly-created file/dir name string to a std::string for return.
@@ -182,6 +188,12 @@ std::string ToolBase::Mktemp(const std::string &filename_template, bool director
 
 VersionNumber ToolBase::GetVersion() const
 {
+	if(!m_version_number.empty())
+	{
+		// We've already run the tool to get its version.
+		return m_version_number;
+	}
+
 	std::stringstream ss;
 	boost::regex version_regex(GetVersionExtractionRegex());
 	boost::cmatch capture_results;
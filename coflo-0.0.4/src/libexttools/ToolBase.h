@@ -37,12 +37,14 @@ public:
 	virtual ~ToolBase();
 	
 	void SetCommand(const std::string &cmd) { m_cmd = cmd; };
+	const std::string& GetCommand() const { return m_cmd; };
 	
 	/**
 	 * Returns the VersionNumber of the tool.
 	 * 
 	 * The version is generally obtained by running the tool with a "--version"
-	 * parameter and parsing the output appropriately.
+	 * parameter and parsing the output appropriately.  This is only done on the first
+	 * call; later calls return the saved result.
 	 *
      * @return The VersionNumber of the tool.
      */
@@ -68,7 +70,7 @@ public:
      * @param filename_template
      * @param directory If true, create a directory instead of a file.
      * @param 
-     * @return 
+     * @return The name of the new file or directory, or an empty string if it couldn't be created.
      */
 	static std::string Mktemp(const std::string &filename_template = "", bool directory = false, bool rooted_in_tmp = true);
 	
@@ -28,10 +28,11 @@
  * - Output <file>.s:
  *		- In working directory by default.
  *		- If "-o file.s", then relative to working directory.
+ * - Output <file>.c.NNNt.gimple, gcc 11 and later:
+ *		- In same directory as <file>.s, but named after the -o file rather than the source file.
  *
- *	The code in GenerateCFG() normalizes this so that the .NNNt.gimple file:
- *	- Always has an extension of ".coflo.gimple".
- *	- Always is put in the current working directory.
+ *	Since every supported gcc puts the dump next to the -o file, GenerateCFG() points -o into
+ *	a directory which is used for nothing else and takes whatever .gimple file shows up there.
  */
 
 #include "ToolCompiler.h"
@@ -58,10 +59,10 @@ ToolCompiler::~ToolCompiler()
 {
 }
 
-int ToolCompiler::GenerateCFG(const std::string &params, const std::string &source_filename)
+int ToolCompiler::GenerateCFG(const std::string &params, const std::string &source_filename,
+		const std::string &output_dir, std::string *dump_filename)
 {
 	int system_retval;
-	int rename_retval;
 	std::vector< std::string > matching_filenames;
 
 	// Create the compile command.
@@ -71,9 +72,14 @@ int ToolCompiler::GenerateCFG(const std::string &params, const std::string &sour
 	// -fno-builtin = Don't silently use builtins for things like alloca, memcpy, etc.  This would make CoFlo's
 	//                output harder to interpret.
 	compile_to_cfg_command = " -fno-builtin -S -fdump-tree-gimple-lineno";
+
+	// Put the .s file, and with it the dump, in output_dir.
+	boost::filesystem::path output_dir_path = output_dir;
+	boost::filesystem::path source_filename_only = boost::filesystem::path(source_filename).filename();
+	std::string output_file_param = " -o \"" + (output_dir_path / (source_filename_only.generic_string() + ".s")).generic_string() + "\"";
 	
 	// Call the compiler to generate the CFG file.
-	system_retval = System(compile_to_cfg_command + params + " " + source_filename);
+	system_retval = System(compile_to_cfg_command + output_file_param + params + " " + source_filename);
 
 	if(system_retval != 0)
 	{
@@ -81,13 +87,10 @@ int ToolCompiler::GenerateCFG(const std::string &params, const std::string &sour
 		return system_retval;
 	}
 
-	// Normalize the output filename by removing the three-digit compile stage number,
-	// which can vary between gcc versions and builds.
-
-	// Create a pattern to glob for.
-	boost::filesystem::path source_filename_only = source_filename;
-	source_filename_only = source_filename_only.filename();
-	std::string filename_to_glob_for = source_filename_only.generic_string()+".????.gimple";
+	// Find the dump.  Its name contains a three-digit compile stage number, which can vary
+	// between gcc versions and builds, and the rest of the name varies between gcc versions too.
+	// Nothing else in output_dir will match though.
+	std::string filename_to_glob_for = (output_dir_path / "*.gimple").generic_string();
 	matching_filenames = Glob(filename_to_glob_for);
 
 	// Check for errors.
@@ -104,10 +107,26 @@ int ToolCompiler::GenerateCFG(const std::string &params, const std::string &sour
 		return 1;
 	}
 
-	// We're OK, rename the file.
-	rename_retval = rename(matching_filenames[0].c_str(), (source_filename_only.generic_string()+".coflo.gimple").c_str());
+	*dump_filename = matching_filenames[0];
+
+	return 0;
+}
 
-	return rename_retval;
+bool ToolCompiler::GenerateCFGToStream(const std::string &params, const std::string &source_filename, std::ostream &dump_output) const
+{
+	// Same flags as GenerateCFG(), but the dump goes to stdout and the .s file goes nowhere.
+	return Popen(" -fno-builtin -S -o /dev/null -fdump-tree-gimple-lineno=stdout" + params + " " + source_filename, dump_output);
+}
+
+bool ToolCompiler::CanDumpToStdout() const
+{
+	// gcc versions < 4.8.0 don't support the "-fdump-tree-<pass>=<filename>" form.
+	return !(GetVersion() < VersionNumber("4.8.0"));
+}
+
+bool ToolCompiler::Preprocess(const std::string &params, const std::string &source_filename, std::ostream &preprocessed_output) const
+{
+	return Popen(" -E" + params + " " + source_filename, preprocessed_output);
 }
 
 std::pair< std::string, bool > ToolCompiler::CheckIfVersionIsUsable() const
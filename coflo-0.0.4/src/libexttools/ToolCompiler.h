@@ -37,13 +37,48 @@ public:
 	
 	/**
 	 * Parse the specified @a source_filename and generate the file containing the SSA representation.
-	 * The resulting file will be named <source_filename>.coflo.cfg.
+	 *
+	 * All the files gcc generates are put in @a output_dir, which should be empty, and which the
+	 * caller is responsible for cleaning up.  Using a separate @a output_dir for each call allows
+	 * several compiles to run at once, even of files with the same name.
+	 *
+	 * @param params
+	 * @param source_filename
+	 * @param output_dir The directory to put gcc's output files in.
+	 * @param[out] dump_filename The path of the resulting GIMPLE dump file.
+	 * @return 0 on success, nonzero on failure.
+	 */
+	int GenerateCFG(const std::string &params, const std::string &source_filename,
+			const std::string &output_dir, std::string *dump_filename);
+
+	/**
+	 * Like GenerateCFG(), but instead of writing any files, gcc sends the dump to its stdout
+	 * and we copy it to @a dump_output as it comes in.  The assembly output is discarded.
+	 *
+	 * Requires a gcc which supports dumping to stdout; see CanDumpToStdout().
 	 *
 	 * @param params
 	 * @param source_filename
-	 * @return
+	 * @param dump_output The stream to write the GIMPLE dump to.
+	 * @return true on success, false if the compile failed.
+	 */
+	bool GenerateCFGToStream(const std::string &params, const std::string &source_filename, std::ostream &dump_output) const;
+
+	/**
+	 * Returns true if this compiler can write its tree dumps to stdout, as required by
+	 * GenerateCFGToStream().
+	 */
+	bool CanDumpToStdout() const;
+
+	/**
+	 * Run @a source_filename through the preprocessor only.
+	 *
+	 * @param params The same -D/-I parameters which would be passed to GenerateCFG().
+	 * @param source_filename The file to preprocess.
+	 * @param preprocessed_output Stream to which the preprocessed source will be written.
+	 * @return true on success, false if the preprocessor failed.
 	 */
-	int GenerateCFG(const std::string &params, const std::string &source_filename);
+	bool Preprocess(const std::string &params, const std::string &source_filename, std::ostream &preprocessed_output) const;
 	
 	std::pair< std::string, bool > CheckIfVersionIsUsable() const;
 	
@@ -34,6 +34,7 @@
 
 #include "Function.h"
 #include "Program.h"
+#include "GimpleDumpCache.h"
 #include "libexttools/ToolCompiler.h"
 #include "libexttools/ToolDot.h"
 #include "controlflowgraph/analysis/Analyzer.h"
@@ -51,8 +52,13 @@ namespace po = boost::program_options;
 #define CLP_DEBUG_PARSE "debug-parse"
 #define CLP_DEBUG_LINK  "debug-link"
 #define CLP_DEBUG_CFG	"debug-cfg"
+#define CLP_PARSE_WITH_DPARSER	"parse-with-dparser"
 #define CLP_TEMPS_DIR	"temps-dir"
 #define CLP_OUTPUT_DIR	"output-dir"
+#define CLP_JOBS	"jobs"
+#define CLP_CACHE_DIR	"cache-dir"
+#define CLP_STREAM_GIMPLE	"stream-gimple"
+#define CLP_PARSE_BY_FUNCTION	"parse-by-function"
 
 #define CLP_DEFINE	"define"
 #define CLP_INCLUDE_DIR	"include-dir"
@@ -125,10 +131,26 @@ int main(int argc, char* argv[])
 	// The CFG output format.
 	std::string cfg_fmt;
 
+	// Number of files to compile and parse in parallel.
+	long num_jobs = 1;
+
+	// The GIMPLE dump cache directory.
+	std::string cache_directory;
+
+	// The directory to put intermediate files in.
+	std::string temps_directory;
+
+	// Whether to pipe the GIMPLE dumps straight from gcc.
+	bool stream_gimple = false;
+
+	// Whether to parse the GIMPLE dumps one function at a time.
+	bool parse_by_function = false;
+
 	// Debug settings.
 	bool debug_parse = false;
 	bool debug_link = false;
 	bool debug_cfg = false;
+	bool parse_with_dparser = false;
 	
 	// Control flow graph option flags.
 	// Whether to limit display to only function calls, or to everything CoFlo
@@ -175,8 +197,17 @@ int main(int argc, char* argv[])
 		(CLP_VERSION",v", "Display the version number and copyright information.")
 		(CLP_BUILD_INFO, "Print information about library versions and options used to build this program.")
 		(CLP_RESPONSE_FILE, po::value<std::string>(&response_filename), "Read command line options from file. Can also be specified with '@name'.")
-		(CLP_TEMPS_DIR, po::value< std::string >(), "The directory in which to put intermediate files during the analysis.")
+		(CLP_TEMPS_DIR, po::value< std::string >(&temps_directory), "The directory in which to put intermediate files during the analysis.  "
+				"Each compile gets its own subdirectory, which is removed once the compiler's output has been read.  "
+				"Defaults to the system's temporary directory.")
+		(CLP_STREAM_GIMPLE, po::bool_switch(&stream_gimple), "Read gcc's intermediate output through a pipe instead of through temporary files.  "
+				"Requires gcc 4.8 or later.")
 		(CLP_OUTPUT_DIR",O", po::value< std::string >(&report_output_directory), "Put HTML report output in the given directory.")
+		(CLP_JOBS",j", po::value< long >(&num_jobs)->default_value(1), "Compile and parse up to this many source files, and check up to this many constraints, in parallel.")
+		(CLP_CACHE_DIR, po::value< std::string >(&cache_directory), "Keep the intermediate files gcc generates in the given directory, "
+				"and reuse them on later runs when the preprocessed source, compiler flags and compiler version haven't changed.")
+		(CLP_PARSE_BY_FUNCTION, po::bool_switch(&parse_by_function), "Parse gcc's intermediate output one function at a time.  "
+				"Reduces peak memory usage on large source files, and with --" CLP_JOBS ", lets the functions of a single file be parsed in parallel.")
 		;
 		preproc_options.add_options()
 		(CLP_DEFINE",D", po::value< std::vector<std::string> >(), "Define a preprocessing macro")
@@ -207,6 +238,8 @@ int main(int argc, char* argv[])
 		(CLP_DEBUG_PARSE, po::bool_switch(&debug_parse), "Print debug info concerning the CFG parsing stage.")
 		(CLP_DEBUG_LINK, po::bool_switch(&debug_link), "Print debug info concerning the CFG linking stage.")
 		(CLP_DEBUG_CFG, po::bool_switch(&debug_cfg), "Print debug info concerning the CFG fix-up stages.")
+		(CLP_PARSE_WITH_DPARSER, po::bool_switch(&parse_with_dparser), "Parse gcc's intermediate output with the full grammar only, "
+				"instead of trying the faster hand-written parser first.")
 		;
 		hidden_options.add_options()
 		(CLP_INPUT_FILE, po::value< std::vector<std::string> >(), "input file")
@@ -335,6 +368,7 @@ int main(int argc, char* argv[])
 			}
 
 			the_program->SetTheFilter(the_filter);
+			the_program->SetNumberOfJobs(num_jobs);
 			ToolCompiler *tool_compiler = new ToolCompiler(the_gcc);
 			std::cout << "Using GCC version: " << tool_compiler->GetVersion() << std::endl;
 
@@ -348,6 +382,27 @@ int main(int argc, char* argv[])
 				return 1;
 			}
 			the_program->SetTheGcc(tool_compiler);
+			if(!temps_directory.empty())
+			{
+				the_program->SetTempsDir(temps_directory);
+			}
+			if(stream_gimple)
+			{
+				if(tool_compiler->CanDumpToStdout())
+				{
+					the_program->SetStreamGimpleDump(true);
+				}
+				else
+				{
+					std::cerr << "WARNING: This version of GCC can't stream its output, ignoring --" CLP_STREAM_GIMPLE "." << std::endl;
+				}
+			}
+			the_program->SetParseByFunction(parse_by_function);
+			the_program->SetParseWithDParser(parse_with_dparser);
+			if(!cache_directory.empty())
+			{
+				the_program->SetGimpleDumpCache(new GimpleDumpCache(cache_directory));
+			}
 			the_program->AddSourceFiles(vm[CLP_INPUT_FILE].as< std::vector<std::string> >());
 
 			// Parse the program.
@@ -425,6 +480,7 @@ int main(int argc, char* argv[])
 		// User wants to run some analysis.
 
 		the_analyzer->AttachToProgram(the_program);
+		the_analyzer->SetNumberOfJobs(num_jobs);
 
 		// Add the given constraints to the analysis.
 		the_analyzer->AddConstraints(vm[CLP_CONSTRAINT].as< std::vector<std::string> >());
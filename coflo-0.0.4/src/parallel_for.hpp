@@ -0,0 +1,123 @@
+/*
+ * Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+ *
+ * This file is part of CoFlo.
+ *
+ * CoFlo is free software: you can redistribute it and/or modify it under the
+ * terms of version 3 of the GNU General Public License as published by the Free
+ * Software Foundation.
+ *
+ * CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/** @file */
+
+#ifndef PARALLEL_FOR_HPP
+#define PARALLEL_FOR_HPP
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+
+namespace detail
+{
+
+/**
+ * The shared state of one parallel_for() call.  Workers pull the next unclaimed
+ * index from here until all of them have been handed out.
+ */
+template < typename IndexFunction >
+class parallel_for_work_queue
+{
+public:
+	parallel_for_work_queue(long num_items, IndexFunction &f) : m_next_index(0), m_num_items(num_items), m_f(f) {};
+
+	/// The body of each worker thread.
+	void operator()()
+	{
+		long index;
+		while(ClaimNextIndex(&index))
+		{
+			m_f(index);
+		}
+	};
+
+private:
+
+	bool ClaimNextIndex(long *index)
+	{
+		boost::lock_guard<boost::mutex> lock(m_mutex);
+
+		if(m_next_index >= m_num_items)
+		{
+			return false;
+		}
+		*index = m_next_index;
+		++m_next_index;
+		return true;
+	};
+
+	boost::mutex m_mutex;
+	long m_next_index;
+	long m_num_items;
+	IndexFunction &m_f;
+};
+
+/// Thread functor which forwards to a parallel_for_work_queue owned by the calling thread.
+template < typename WorkQueue >
+struct parallel_for_worker
+{
+	parallel_for_worker(WorkQueue *work_queue) : m_work_queue(work_queue) {};
+
+	void operator()() { (*m_work_queue)(); };
+
+	WorkQueue *m_work_queue;
+};
+
+}
+
+/**
+ * Call f(i) for every i in [0, num_items), using up to @a num_jobs threads.
+ *
+ * Indices are handed out in increasing order, but the calls may complete in any order.
+ * Returns once every call has completed.  With @a num_jobs <= 1 this is an ordinary
+ * serial loop on the calling thread.
+ *
+ * @param num_jobs The maximum number of threads to run @a f on.
+ * @param num_items The number of indices to process.
+ * @param f The function object to call.  Must be safe to call concurrently with different indices.
+ */
+template < typename IndexFunction >
+void parallel_for(long num_jobs, long num_items, IndexFunction f)
+{
+	if(num_jobs <= 1 || num_items <= 1)
+	{
+		for(long i=0; i<num_items; ++i)
+		{
+			f(i);
+		}
+		return;
+	}
+
+	if(num_jobs > num_items)
+	{
+		num_jobs = num_items;
+	}
+
+	typedef detail::parallel_for_work_queue<IndexFunction> T_WORK_QUEUE;
+	T_WORK_QUEUE work_queue(num_items, f);
+
+	boost::thread_group workers;
+	for(long i=0; i<num_jobs; ++i)
+	{
+		workers.create_thread(detail::parallel_for_worker<T_WORK_QUEUE>(&work_queue));
+	}
+	workers.join_all();
+}
+
+#endif /* PARALLEL_FOR_HPP */
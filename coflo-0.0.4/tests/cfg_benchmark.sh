@@ -0,0 +1,58 @@
+#!/bin/sh
+# cfg_benchmark.sh for CoFlo
+#
+# Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+#
+# This file is part of CoFlo.
+#
+# CoFlo is free software: you can redistribute it and/or modify it under the
+# terms of version 3 of the GNU General Public License as published by the Free
+# Software Foundation.
+#
+# CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+# PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU General Public License along with
+# CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+
+# Times building the control flow graph of one very large function.
+#
+# Usage: cfg_benchmark.sh [coflo] [number of statement blocks]
+#
+# The GIMPLE dump is cached up front with --cache-dir, so that the timings are of the parse
+# and the CFG construction and not the compile.  Run it with --debug-cfg off (the default),
+# otherwise the time goes to printing.
+
+COFLO=${1:-coflo}
+NUM_BLOCKS=${2:-5000}
+
+WORKDIR=`mktemp -d "${TMPDIR:-/tmp}/coflo_cfg_benchmark.XXXXXX"` || exit 1
+trap 'rm -rf "$WORKDIR"' 0
+
+# Generate the function.  Each block contributes a few assignments, an if/else, a call and a
+# loop, so the CFG gets plenty of Merge and NoOp vertices from the fixups as well.
+{
+	echo "extern void sink(int x);"
+	echo "int big(int x, int *p)"
+	echo "{"
+	echo "	int j, sum = 0;"
+	b=0
+	while test $b -lt $NUM_BLOCKS; do
+		echo "	if(x > $b) { sum += p[$b]; } else { sum -= $b; }"
+		echo "	if(sum & 1) { sink(sum); }"
+		echo "	for(j = 0; j < (x & 3); j++) { sum ^= j; }"
+		b=`expr $b + 1`
+	done
+	echo "	return sum;"
+	echo "}"
+	echo "int main(void) { int a[$NUM_BLOCKS]; return big(1, a); }"
+} > "$WORKDIR/big.c"
+
+# Warm the cache.
+"$COFLO" --cache-dir="$WORKDIR/cache" "$WORKDIR/big.c" > /dev/null 2>&1
+
+echo "== CFG construction, $NUM_BLOCKS blocks"
+time "$COFLO" --cache-dir="$WORKDIR/cache" "$WORKDIR/big.c" > /dev/null 2>&1
+time "$COFLO" --cache-dir="$WORKDIR/cache" "$WORKDIR/big.c" > /dev/null 2>&1
+time "$COFLO" --cache-dir="$WORKDIR/cache" "$WORKDIR/big.c" > /dev/null 2>&1
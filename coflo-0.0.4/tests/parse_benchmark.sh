@@ -0,0 +1,80 @@
+#!/bin/sh
+# parse_benchmark.sh for CoFlo
+#
+# Copyright 2012 Gary R. Van Sickle (grvs@users.sourceforge.net).
+#
+# This file is part of CoFlo.
+#
+# CoFlo is free software: you can redistribute it and/or modify it under the
+# terms of version 3 of the GNU General Public License as published by the Free
+# Software Foundation.
+#
+# CoFlo is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+# PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+# 
+# You should have received a copy of the GNU General Public License along with
+# CoFlo.  If not, see <http://www.gnu.org/licenses/>.
+
+# Times the GIMPLE parse with the fast parser against the dparser grammar alone.
+#
+# Usage: parse_benchmark.sh [coflo] [number of files] [functions per file]
+#
+# Both the test suite's own sources and a generated corpus are measured.  The GIMPLE dumps
+# are cached up front with --cache-dir, so that the timings are of the parse and not the compile.
+
+COFLO=${1:-coflo}
+NUM_FILES=${2:-64}
+NUM_FUNCTIONS=${3:-200}
+
+SRCDIR=`dirname "$0"`
+WORKDIR=`mktemp -d "${TMPDIR:-/tmp}/coflo_parse_benchmark.XXXXXX"` || exit 1
+trap 'rm -rf "$WORKDIR"' 0
+
+# Generate the synthetic corpus.
+mkdir "$WORKDIR/corpus"
+i=0
+while test $i -lt $NUM_FILES; do
+	{
+		echo "extern int printf(const char *format, ...);"
+		f=0
+		while test $f -lt $NUM_FUNCTIONS; do
+			echo "int func_${i}_$f(int x, int *p)"
+			echo "{"
+			echo "	int j, sum = 0;"
+			echo "	for(j = 0; j < x; j++)"
+			echo "	{"
+			echo "		if(j & $f) { sum += p[j]; } else { sum -= $f; }"
+			echo "		if(sum > 1000) { printf(\"overflow %d\\n\", sum); goto out; }"
+			echo "	}"
+			echo "	switch(x) { case 1: sum++; break; case 2: sum--; break; default: break; }"
+			echo "out:"
+			echo "	return sum;"
+			echo "}"
+			f=`expr $f + 1`
+		done
+	} > "$WORKDIR/corpus/file_$i.c"
+	i=`expr $i + 1`
+done
+echo "int main(void) { return 0; }" > "$WORKDIR/corpus/main.c"
+
+# Runs coflo over the given sources, once to warm the cache, then once with each parser.
+run_benchmark()
+{
+	name=$1
+	shift
+
+	"$COFLO" --cache-dir="$WORKDIR/cache" "$@" --cfg=main > /dev/null 2>&1
+
+	echo "== $name: --parse-with-dparser"
+	time "$COFLO" --cache-dir="$WORKDIR/cache" --parse-with-dparser "$@" --cfg=main > "$WORKDIR/dparser.out" 2>&1
+	echo "== $name: fast parser"
+	time "$COFLO" --cache-dir="$WORKDIR/cache" "$@" --cfg=main > "$WORKDIR/fast.out" 2>&1
+
+	if ! cmp -s "$WORKDIR/dparser.out" "$WORKDIR/fast.out"; then
+		echo "WARNING: $name: the two parsers' output differs."
+	fi
+}
+
+run_benchmark "test_src_1" "$SRCDIR"/test_src_1/*.c
+run_benchmark "synthetic corpus ($NUM_FILES files, $NUM_FUNCTIONS functions each)" "$WORKDIR"/corpus/*.c